@@ -0,0 +1,123 @@
+//===--------------------------------------------------------------------------------------------===
+// alloc - allocation throughput benchmark
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/memory.h>
+#include <ccore/time.h>
+#include <ccore/log.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Measures small-block allocation throughput as the number of threads grows, for cc_alloc() and
+// the C library's malloc(). Configure with -DCCORE_TCACHE=ON to measure the thread-local cache.
+//
+// - local: each thread allocates and frees batches of blocks of mixed sizes.
+// - handoff: threads are paired; one allocates batches that the other frees, like ccpool tasks.
+
+#define ITERATIONS (2000)
+#define BATCH (256)
+#define MAX_THREADS (16)
+
+typedef struct {
+    void *(*alloc)(size_t);
+    void (*free)(void *);
+} allocator_t;
+
+typedef struct {
+    const allocator_t *allocator;
+    void *batch[BATCH];
+    atomic_bool full;
+    unsigned seed;
+} job_t;
+
+static const allocator_t cc_allocator_fns = { cc_alloc, cc_free };
+static const allocator_t libc_allocator_fns = { malloc, free };
+
+static inline size_t block_size(unsigned *seed) {
+    return 16 + rand_r(seed) % 240;
+}
+
+static void *local_worker(void *data) {
+    job_t *job = data;
+    for(int i = 0; i < ITERATIONS; ++i) {
+        for(int j = 0; j < BATCH; ++j) job->batch[j] = job->allocator->alloc(block_size(&job->seed));
+        for(int j = 0; j < BATCH; ++j) job->allocator->free(job->batch[j]);
+    }
+    return NULL;
+}
+
+static void *producer(void *data) {
+    job_t *job = data;
+    for(int i = 0; i < ITERATIONS; ++i) {
+        while(atomic_load_explicit(&job->full, memory_order_acquire)) sched_yield();
+        for(int j = 0; j < BATCH; ++j) job->batch[j] = job->allocator->alloc(block_size(&job->seed));
+        atomic_store_explicit(&job->full, true, memory_order_release);
+    }
+    return NULL;
+}
+
+static void *consumer(void *data) {
+    job_t *job = data;
+    for(int i = 0; i < ITERATIONS; ++i) {
+        while(!atomic_load_explicit(&job->full, memory_order_acquire)) sched_yield();
+        for(int j = 0; j < BATCH; ++j) job->allocator->free(job->batch[j]);
+        atomic_store_explicit(&job->full, false, memory_order_release);
+    }
+    return NULL;
+}
+
+// Returns the throughput in millions of alloc/free pairs per second.
+static double run(const allocator_t *allocator, int threads, bool handoff) {
+    static job_t jobs[MAX_THREADS];
+    pthread_t workers[MAX_THREADS];
+
+    int job_count = handoff ? threads / 2 : threads;
+    for(int i = 0; i < job_count; ++i) {
+        jobs[i].allocator = allocator;
+        jobs[i].seed = i + 1;
+        atomic_store(&jobs[i].full, false);
+    }
+
+    uint64_t start = cc_microtime();
+    for(int i = 0; i < job_count; ++i) {
+        if(handoff) {
+            pthread_create(&workers[2*i], NULL, producer, &jobs[i]);
+            pthread_create(&workers[2*i+1], NULL, consumer, &jobs[i]);
+        } else {
+            pthread_create(&workers[i], NULL, local_worker, &jobs[i]);
+        }
+    }
+    for(int i = 0; i < (handoff ? job_count * 2 : job_count); ++i) {
+        pthread_join(workers[i], NULL);
+    }
+    uint64_t elapsed = cc_microtime() - start;
+
+    double pairs = (double)job_count * ITERATIONS * BATCH;
+    return pairs / (double)elapsed;
+}
+
+int main() {
+    static const int thread_counts[] = {1, 2, 4, 8, 16};
+
+    printf("%-8s %8s %14s %14s\n", "test", "threads", "cc_alloc M/s", "malloc M/s");
+    for(size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++i) {
+        int threads = thread_counts[i];
+        printf("%-8s %8d %14.2f %14.2f\n", "local", threads,
+            run(&cc_allocator_fns, threads, false),
+            run(&libc_allocator_fns, threads, false));
+    }
+    for(size_t i = 1; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++i) {
+        int threads = thread_counts[i];
+        printf("%-8s %8d %14.2f %14.2f\n", "handoff", threads,
+            run(&cc_allocator_fns, threads, true),
+            run(&libc_allocator_fns, threads, true));
+    }
+    return 0;
+}
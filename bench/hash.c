@@ -0,0 +1,97 @@
+//===--------------------------------------------------------------------------------------------===
+// hash - string hashing throughput and distribution benchmark
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/hash.h>
+#include <ccore/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Compares cc_hash_bytes() with the byte-at-a-time FNV-1a hash cctable_t used to use.
+//
+// - throughput: GB/s hashing keys of a fixed length, for a range of lengths.
+// - distribution: sequential keys ("key0", "key1", ...) are spread into 2^16 buckets using the
+//   same bits as the table index, and the chi-squared score of the bucket counts is reported.
+//   A good hash scores close to the number of buckets.
+
+#define BUFFER_SIZE (1 << 20)
+#define TOTAL_BYTES (256u << 20)
+#define DIST_KEYS (1 << 20)
+#define DIST_BUCKET_BITS (16)
+
+typedef uint64_t (*hash_fn_t)(const void *, size_t);
+
+static uint64_t fnv1a(const void *data, size_t length) {
+    const unsigned char *p = data;
+    uint64_t hash = 0x84222325cbf29ce4ULL;
+    for(size_t i = 0; i < length; ++i) {
+        hash = (hash ^ p[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static uint64_t cc_hash(const void *data, size_t length) {
+    return cc_hash_bytes(data, length, 0);
+}
+
+// Returns the throughput in GB/s for keys of [length] bytes.
+static double throughput(hash_fn_t hash, const unsigned char *buffer, size_t length) {
+    size_t keys = TOTAL_BYTES / length;
+    size_t span = BUFFER_SIZE - length;
+    volatile uint64_t sink = 0;
+
+    uint64_t start = cc_microtime();
+    for(size_t i = 0; i < keys; ++i) {
+        sink ^= hash(buffer + (i * 61) % span, length);
+    }
+    uint64_t elapsed = cc_microtime() - start;
+    (void)sink;
+    return (double)keys * length / (elapsed * 1e3);
+}
+
+// Buckets are picked with the bits above the 7 used for control bytes, like the table index.
+static double chi_squared(hash_fn_t hash) {
+    size_t buckets = 1 << DIST_BUCKET_BITS;
+    unsigned *counts = calloc(buckets, sizeof(unsigned));
+    char key[32];
+    for(int i = 0; i < DIST_KEYS; ++i) {
+        int length = snprintf(key, sizeof(key), "key%d", i);
+        counts[(hash(key, length) >> 7) & (buckets - 1)] += 1;
+    }
+
+    double expected = (double)DIST_KEYS / buckets;
+    double chi = 0;
+    for(size_t i = 0; i < buckets; ++i) {
+        double d = counts[i] - expected;
+        chi += d * d / expected;
+    }
+    free(counts);
+    return chi;
+}
+
+int main() {
+    static const size_t lengths[] = {4, 8, 16, 32, 64, 128, 256, 1024, 4096};
+
+    unsigned char *buffer = malloc(BUFFER_SIZE);
+    srand(1);
+    for(size_t i = 0; i < BUFFER_SIZE; ++i) buffer[i] = rand();
+
+    printf("%8s %14s %14s\n", "length", "cc_hash GB/s", "fnv1a GB/s");
+    for(size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+        printf("%8zu %14.2f %14.2f\n", lengths[i],
+            throughput(cc_hash, buffer, lengths[i]),
+            throughput(fnv1a, buffer, lengths[i]));
+    }
+
+    printf("\nchi-squared over %d buckets (a uniform hash scores close to %d)\n",
+        1 << DIST_BUCKET_BITS, 1 << DIST_BUCKET_BITS);
+    printf("%8s %14.0f\n%8s %14.0f\n", "cc_hash", chi_squared(cc_hash), "fnv1a", chi_squared(fnv1a));
+
+    free(buffer);
+    return 0;
+}
@@ -0,0 +1,104 @@
+//===--------------------------------------------------------------------------------------------===
+// map - integer-keyed lookup benchmark
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/frozen.h>
+#include <ccore/map.h>
+#include <ccore/time.h>
+#include <stdio.h>
+
+// Compares lookups of integer IDs, for a range of map sizes, in:
+//
+// - a map generated with CC_MAP_DEFINE(), with the value stored inline;
+// - ccmap_u64_t, where values are void pointers behind out-of-line calls;
+// - cctable_t, with IDs formatted as strings like callers used to do;
+// - the same table, frozen with cctable_freeze().
+//
+// Lookups hit keys in a pseudo-random order, and half of them miss.
+
+#define LOOKUPS (1 << 22)
+
+typedef struct {
+    float x, y, z;
+} position_t;
+
+CC_MAP_DEFINE(posmap, uint64_t, position_t, cc_hash_u64, CC_MAP_EQ)
+
+static inline uint64_t key_at(size_t i, size_t count) {
+    return (i * 0x9e3779b97f4a7c15ull) % (count * 2);
+}
+
+static double bench_generated(size_t count) {
+    posmap_t map;
+    posmap_init(&map, count);
+    for(size_t i = 0; i < count * 2; i += 2) posmap_insert(&map, i, (position_t){i, 0, 0});
+
+    float sink = 0;
+    uint64_t start = cc_microtime();
+    for(size_t i = 0; i < LOOKUPS; ++i) {
+        const position_t *p = posmap_get(&map, key_at(i, count));
+        if(p) sink += p->x;
+    }
+    uint64_t elapsed = cc_microtime() - start;
+    posmap_deinit(&map);
+    return sink >= 0 ? elapsed * 1e3 / LOOKUPS : 0;
+}
+
+static double bench_u64(size_t count) {
+    ccmap_u64_t map;
+    ccmap_u64_init(&map, count);
+    for(size_t i = 0; i < count * 2; i += 2) ccmap_u64_insert(&map, i, (void *)(i + 1));
+
+    uintptr_t sink = 0;
+    uint64_t start = cc_microtime();
+    for(size_t i = 0; i < LOOKUPS; ++i) {
+        sink += (uintptr_t)ccmap_u64_get(&map, key_at(i, count));
+    }
+    uint64_t elapsed = cc_microtime() - start;
+    ccmap_u64_deinit(&map, NULL, NULL);
+    return sink ? elapsed * 1e3 / LOOKUPS : 0;
+}
+
+static double bench_table(size_t count, bool frozen) {
+    char key[32];
+    cctable_t table;
+    cctable_init(&table, count, false);
+    for(size_t i = 0; i < count * 2; i += 2) {
+        snprintf(key, sizeof(key), "%zu", i);
+        cctable_insert(&table, key, (void *)(i + 1));
+    }
+    ccfrozen_table_t frozen_table;
+    if(frozen) cctable_freeze(&table, &frozen_table);
+
+    uintptr_t sink = 0;
+    uint64_t start = cc_microtime();
+    for(size_t i = 0; i < LOOKUPS; ++i) {
+        snprintf(key, sizeof(key), "%llu", (unsigned long long)key_at(i, count));
+        sink += (uintptr_t)(frozen
+            ? ccfrozen_get(&frozen_table, key)
+            : cctable_get_one(&table, key));
+    }
+    uint64_t elapsed = cc_microtime() - start;
+    if(frozen) ccfrozen_deinit(&frozen_table);
+    cctable_deinit(&table, NULL, NULL);
+    return sink ? elapsed * 1e3 / LOOKUPS : 0;
+}
+
+int main() {
+    static const size_t counts[] = {64, 1024, 16384, 262144, 1 << 21};
+
+    printf("ns per lookup\n%10s %12s %12s %12s %12s\n",
+        "keys", "generated", "ccmap_u64", "cctable", "frozen");
+    for(size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        printf("%10zu %12.1f %12.1f %12.1f %12.1f\n", counts[i],
+            bench_generated(counts[i]),
+            bench_u64(counts[i]),
+            bench_table(counts[i], false),
+            bench_table(counts[i], true));
+    }
+    return 0;
+}
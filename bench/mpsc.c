@@ -0,0 +1,107 @@
+//===--------------------------------------------------------------------------------------------===
+// mpsc - multi-producer queue handoff benchmark
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/list.h>
+#include <ccore/mpsc.h>
+#include <ccore/time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+// Measures how many events per second a single consumer receives from a growing number of
+// producer threads, through ccmpsc_t and through a cclist_t behind a mutex, which is what callers
+// had to do before. Events are preallocated, so only the handoff itself is measured.
+
+#define EVENTS_PER_PRODUCER (1 << 18)
+#define MAX_PRODUCERS (8)
+#define DRAIN_BATCH (256)
+
+typedef struct {
+    uint64_t payload;
+    cclist_node_t node;
+} event_t;
+
+typedef struct {
+    bool locked;
+    event_t *events;
+} producer_t;
+
+static event_t events[MAX_PRODUCERS][EVENTS_PER_PRODUCER];
+static ccmpsc_t queue;
+static cclist_t list;
+static pthread_mutex_t list_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void *producer(void *data) {
+    producer_t *job = data;
+    for(size_t i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+        if(job->locked) {
+            pthread_mutex_lock(&list_mutex);
+            cclist_insert_last(&list, &job->events[i]);
+            pthread_mutex_unlock(&list_mutex);
+        } else {
+            ccmpsc_push(&queue, &job->events[i]);
+        }
+    }
+    return NULL;
+}
+
+static void consume(void *object, void *user_data) {
+    *(uint64_t *)user_data += ((event_t *)object)->payload;
+}
+
+// Takes up to DRAIN_BATCH events at a time, under a single lock, like a batched consumer would.
+static size_t drain_locked(uint64_t *sink) {
+    size_t count = 0;
+    pthread_mutex_lock(&list_mutex);
+    while(count < DRAIN_BATCH && list.size) {
+        event_t *event = cclist_first(&list);
+        cclist_remove_first(&list);
+        *sink += event->payload;
+        count += 1;
+    }
+    pthread_mutex_unlock(&list_mutex);
+    return count;
+}
+
+static double run(int producers, bool locked) {
+    ccmpsc_init(&queue, offsetof(event_t, node));
+    cclist_init(&list, offsetof(event_t, node));
+
+    pthread_t threads[MAX_PRODUCERS];
+    producer_t jobs[MAX_PRODUCERS];
+    uint64_t start = cc_microtime();
+    for(int i = 0; i < producers; ++i) {
+        jobs[i] = (producer_t){locked, events[i]};
+        pthread_create(&threads[i], NULL, producer, &jobs[i]);
+    }
+
+    uint64_t sink = 0;
+    size_t total = (size_t)producers * EVENTS_PER_PRODUCER;
+    for(size_t received = 0; received < total;) {
+        size_t count = locked
+            ? drain_locked(&sink)
+            : ccmpsc_drain(&queue, DRAIN_BATCH, consume, &sink);
+        if(!count) sched_yield();
+        received += count;
+    }
+    uint64_t elapsed = cc_microtime() - start;
+    for(int i = 0; i < producers; ++i) pthread_join(threads[i], NULL);
+    return sink ? total / (elapsed / 1e6) / 1e6 : 0;
+}
+
+int main() {
+    for(int i = 0; i < MAX_PRODUCERS; ++i) {
+        for(size_t j = 0; j < EVENTS_PER_PRODUCER; ++j) events[i][j].payload = j + 1;
+    }
+
+    printf("millions of events per second\n%10s %12s %12s\n", "producers", "ccmpsc", "locked");
+    for(int producers = 1; producers <= MAX_PRODUCERS; producers *= 2) {
+        printf("%10d %12.2f %12.2f\n", producers, run(producers, false), run(producers, true));
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+//===--------------------------------------------------------------------------------------------===
+// shared_table - concurrent table lookup scaling benchmark
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/shared_table.h>
+#include <ccore/table.h>
+#include <ccore/time.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Measures lookup throughput as the number of threads grows, for ccshared_table_t and for a
+// cctable_t behind a single mutex, which is what callers had to do before.
+//
+// - read: every operation is a lookup.
+// - mixed: one operation in 16 removes a key and inserts it back.
+//
+// Each thread does the same amount of work, so a table that scales has a throughput that grows
+// with the thread count, as long as there are enough cores.
+
+#define KEYS (1 << 16)
+#define OPERATIONS (1 << 20)
+#define MAX_THREADS (16)
+
+typedef struct {
+    bool mixed;
+    unsigned seed;
+} job_t;
+
+static char keys[KEYS][16];
+static ccshared_table_t shared;
+static cctable_t locked;
+static pthread_mutex_t locked_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void *shared_worker(void *data) {
+    job_t *job = data;
+    uintptr_t sink = 0;
+    for(int i = 0; i < OPERATIONS; ++i) {
+        const char *key = keys[rand_r(&job->seed) % KEYS];
+        if(job->mixed && (i & 15) == 0) {
+            void *value;
+            if(!ccshared_table_remove(&shared, key, &value)) continue;
+            ccshared_table_insert(&shared, key, value);
+        } else {
+            sink += (uintptr_t)ccshared_table_get(&shared, key);
+        }
+    }
+    return (void *)sink;
+}
+
+static void *locked_worker(void *data) {
+    job_t *job = data;
+    uintptr_t sink = 0;
+    for(int i = 0; i < OPERATIONS; ++i) {
+        const char *key = keys[rand_r(&job->seed) % KEYS];
+        pthread_mutex_lock(&locked_mutex);
+        if(job->mixed && (i & 15) == 0) {
+            void *value = cctable_get_one(&locked, key);
+            if(cctable_remove(&locked, key, NULL, NULL)) cctable_insert(&locked, key, value);
+        } else {
+            sink += (uintptr_t)cctable_get_one(&locked, key);
+        }
+        pthread_mutex_unlock(&locked_mutex);
+    }
+    return (void *)sink;
+}
+
+// Returns the throughput in millions of operations per second.
+static double run(bool use_shared, bool mixed, int threads) {
+    static job_t jobs[MAX_THREADS];
+    pthread_t workers[MAX_THREADS];
+
+    uint64_t start = cc_microtime();
+    for(int i = 0; i < threads; ++i) {
+        jobs[i] = (job_t){mixed, i + 1};
+        pthread_create(&workers[i], NULL, use_shared ? shared_worker : locked_worker, &jobs[i]);
+    }
+    for(int i = 0; i < threads; ++i) pthread_join(workers[i], NULL);
+    uint64_t elapsed = cc_microtime() - start;
+    return (double)threads * OPERATIONS / (double)elapsed;
+}
+
+int main() {
+    static const int thread_counts[] = {1, 2, 4, 8, 16};
+
+    ccshared_table_init(&shared, KEYS, 0);
+    cctable_init(&locked, KEYS, false);
+    for(int i = 0; i < KEYS; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+        ccshared_table_insert(&shared, keys[i], (void *)(uintptr_t)(i + 1));
+        cctable_insert(&locked, keys[i], (void *)(uintptr_t)(i + 1));
+    }
+
+    printf("%-8s %8s %14s %14s\n", "test", "threads", "shared M/s", "locked M/s");
+    for(int mixed = 0; mixed < 2; ++mixed) {
+        for(size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++i) {
+            int threads = thread_counts[i];
+            printf("%-8s %8d %14.2f %14.2f\n", mixed ? "mixed" : "read", threads,
+                run(true, mixed, threads),
+                run(false, mixed, threads));
+        }
+    }
+
+    ccshared_table_deinit(&shared, NULL, NULL);
+    cctable_deinit(&locked, NULL, NULL);
+    return 0;
+}
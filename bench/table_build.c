@@ -0,0 +1,72 @@
+//===--------------------------------------------------------------------------------------------===
+// table_build - bulk table loading benchmark
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/memory.h>
+#include <ccore/table.h>
+#include <ccore/time.h>
+#include <ccore/tpool.h>
+#include <stdio.h>
+
+// Compares loading a table from arrays of keys and values, where one key in eight is repeated:
+//
+// - with cctable_insert() in a loop, on a table initialised without a size hint;
+// - with cctable_build(), with the thread pool stopped;
+// - with cctable_build(), with the thread pool running.
+
+#define KEY_SIZE (24)
+#define POOL_THREADS (4)
+
+static double load_insert(const char *const *keys, void *const *values, size_t count) {
+    cctable_t table;
+    cctable_init(&table, 0, false);
+    uint64_t start = cc_microtime();
+    for(size_t i = 0; i < count; ++i) cctable_insert(&table, keys[i], values[i]);
+    uint64_t elapsed = cc_microtime() - start;
+    cctable_deinit(&table, NULL, NULL);
+    return elapsed / 1e3;
+}
+
+static double load_build(const char *const *keys, void *const *values, size_t count) {
+    cctable_t table;
+    cctable_init(&table, 0, false);
+    uint64_t start = cc_microtime();
+    cctable_build(&table, keys, values, count);
+    uint64_t elapsed = cc_microtime() - start;
+    cctable_deinit(&table, NULL, NULL);
+    return elapsed / 1e3;
+}
+
+int main() {
+    static const size_t counts[] = {16384, 262144, 1 << 21};
+
+    printf("ms per load\n%10s %12s %12s %12s\n", "keys", "insert", "build", "build/pool");
+    for(size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        size_t count = counts[i];
+        char *storage = cc_alloc(count * KEY_SIZE);
+        const char **keys = cc_alloc(count * sizeof(char *));
+        void **values = cc_alloc(count * sizeof(void *));
+        for(size_t j = 0; j < count; ++j) {
+            size_t id = j % 8 ? j : j / 8;
+            keys[j] = storage + j * KEY_SIZE;
+            snprintf(storage + j * KEY_SIZE, KEY_SIZE, "user/%zu", id);
+            values[j] = (void *)(j + 1);
+        }
+
+        double insert = load_insert(keys, values, count);
+        double build = load_build(keys, values, count);
+        ccpool_start(POOL_THREADS);
+        double pooled = load_build(keys, values, count);
+        ccpool_stop();
+        printf("%10zu %12.2f %12.2f %12.2f\n", count, insert, build, pooled);
+
+        cc_free(values);
+        cc_free(keys);
+        cc_free(storage);
+    }
+    return 0;
+}
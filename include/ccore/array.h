@@ -7,32 +7,189 @@
 // =^•.•^=
 //===--------------------------------------------------------------------------------------------===
 #pragma once
+#include <ccore/log.h>
 #include <ccore/memory.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef struct ccarray_s {
-    size_t capacity;
+/// The untyped storage behind every vector. Functions working on it take the size of an element,
+/// and are normally called through the CC_VEC_* macros, which fill it in.
+typedef struct ccvec_base_s {
+    void *data;
     size_t count;
-    void **data;
-} ccarray_t;
+    size_t capacity;
+    const cc_allocator_t *allocator;
+    void *inline_data;
+    size_t inline_capacity;
+} ccvec_base_t;
+
+/// A growable array that stores values of type [T] inline. Declare vector types with
+/// `typedef CC_VEC(int) int_vec_t;`, then access elements directly through `vec.data[i]`.
+#define CC_VEC(T)                                                                                 \
+    union {                                                                                       \
+        ccvec_base_t base;                                                                        \
+        struct {                                                                                  \
+            T *data;                                                                              \
+            size_t count;                                                                         \
+            size_t capacity;                                                                      \
+            const cc_allocator_t *allocator;                                                      \
+            T *inline_data;                                                                       \
+            size_t inline_capacity;                                                               \
+        };                                                                                        \
+    }
+
+/// A vector that stores up to [N] values of type [T] inline, and only allocates storage once it
+/// grows past that. It is used through the same CC_VEC_* macros as CC_VEC(T), but must be
+/// initialised with CC_SMALL_VEC_INIT(). Small vectors point into themselves, and cannot be
+/// copied or moved once initialised.
+#define CC_SMALL_VEC(T, N)                                                                        \
+    struct {                                                                                      \
+        CC_VEC(T);                                                                                \
+        T inline_storage[N];                                                                      \
+    }
+
+/// Initialises [vec]. Nothing is allocated until the first element is added.
+void ccvec_init(ccvec_base_t *vec, const cc_allocator_t *allocator);
+
+/// Initialises [vec] to use the [capacity] elements at [storage] until it outgrows them.
+void ccvec_init_inline(
+    ccvec_base_t *vec,
+    const cc_allocator_t *allocator,
+    void *storage,
+    size_t capacity
+);
+
+/// Frees the storage of [vec].
+void ccvec_deinit(ccvec_base_t *vec, size_t elem_size);
+
+/// Makes sure [vec] can hold at least [capacity] elements without reallocating.
+void ccvec_reserve(ccvec_base_t *vec, size_t elem_size, size_t capacity);
+
+/// Makes sure there is room for [count] more elements in [vec], growing it geometrically.
+void ccvec_reserve_more(ccvec_base_t *vec, size_t elem_size, size_t count);
+
+/// Shrinks the storage of [vec] to exactly what its elements need.
+void ccvec_shrink_to_fit(ccvec_base_t *vec, size_t elem_size);
+
+/// Opens a gap of [count] elements at [index] in [vec], and returns a pointer to it.
+void *ccvec_insert_gap(ccvec_base_t *vec, size_t elem_size, size_t index, size_t count);
+
+/// Removes [count] elements from [vec] starting at [index], keeping the others in order.
+void ccvec_remove(ccvec_base_t *vec, size_t elem_size, size_t index, size_t count);
+
+/// Copies [count] elements from [elements] to the end of [vec]. [elements] can point into [vec].
+void ccvec_append(ccvec_base_t *vec, size_t elem_size, const void *elements, size_t count);
+
+/// Removes the last element of [vec], which must not be empty, and returns its index.
+static inline size_t ccvec_pop_index(ccvec_base_t *vec) {
+    CCASSERT(vec->count);
+    return --vec->count;
+}
+
+/// Removes the last element of [vec] so it can be moved to [index], which must be in bounds, and
+/// returns its index.
+static inline size_t ccvec_swap_index(ccvec_base_t *vec, size_t index) {
+    CCASSERT(index < vec->count);
+    return --vec->count;
+}
+
+#define CC_VEC_ELEM_SIZE(vec) (sizeof(*(vec)->data))
+
+/// Initialises [vec] so that its storage is allocated with cc_alloc().
+#define CC_VEC_INIT(vec) ccvec_init(&(vec)->base, NULL)
+
+/// Initialises [vec] so that its storage is allocated with [allocator].
+#define CC_VEC_INIT_WITH(vec, allocator) ccvec_init(&(vec)->base, (allocator))
 
-///
+/// Initialises the small vector [vec] so that it spills to storage allocated with cc_alloc().
+#define CC_SMALL_VEC_INIT(vec) CC_SMALL_VEC_INIT_WITH(vec, NULL)
+
+/// Initialises the small vector [vec] so that it spills to storage allocated with [allocator].
+#define CC_SMALL_VEC_INIT_WITH(vec, allocator)                                                    \
+    ccvec_init_inline(                                                                            \
+        &(vec)->base,                                                                             \
+        (allocator),                                                                              \
+        (vec)->inline_storage,                                                                    \
+        sizeof((vec)->inline_storage) / CC_VEC_ELEM_SIZE(vec)                                     \
+    )
+
+/// Frees the storage of [vec].
+#define CC_VEC_DEINIT(vec) ccvec_deinit(&(vec)->base, CC_VEC_ELEM_SIZE(vec))
+
+/// Removes every element from [vec], but keeps its storage.
+#define CC_VEC_CLEAR(vec) ((void)((vec)->count = 0))
+
+/// Makes sure [vec] can hold at least [n] elements without reallocating.
+#define CC_VEC_RESERVE(vec, n) ccvec_reserve(&(vec)->base, CC_VEC_ELEM_SIZE(vec), (n))
+
+/// Shrinks the storage of [vec] to exactly what its elements need. Small vectors move their
+/// elements back inline when they fit.
+#define CC_VEC_SHRINK_TO_FIT(vec) ccvec_shrink_to_fit(&(vec)->base, CC_VEC_ELEM_SIZE(vec))
+
+/// Adds [value] at the end of [vec].
+#define CC_VEC_PUSH(vec, value)                                                                   \
+    (ccvec_reserve_more(&(vec)->base, CC_VEC_ELEM_SIZE(vec), 1),                                  \
+     (void)((vec)->data[(vec)->count++] = (value)))
+
+/// Removes the last element of [vec] and returns it.
+#define CC_VEC_POP(vec) ((vec)->data[ccvec_pop_index(&(vec)->base)])
+
+/// Returns the last element of [vec].
+#define CC_VEC_LAST(vec) ((vec)->data[(vec)->count - 1])
+
+/// Inserts [value] at [index] in [vec], moving the elements after it up by one. [value] must be
+/// an lvalue of the element type, since it is copied into the gap once the vector has grown.
+#define CC_VEC_INSERT(vec, index, value)                                                          \
+    ((void)memcpy(                                                                                \
+        ccvec_insert_gap(&(vec)->base, CC_VEC_ELEM_SIZE(vec), (index), 1),                        \
+        &(value),                                                                                 \
+        CC_VEC_ELEM_SIZE(vec)))
+
+/// Removes the element at [index] from [vec], keeping the other elements in order.
+#define CC_VEC_REMOVE(vec, index) ccvec_remove(&(vec)->base, CC_VEC_ELEM_SIZE(vec), (index), 1)
+
+/// Removes the element at [index] from [vec] in constant time, by moving the last element into
+/// its slot. This does not preserve the order of elements.
+#define CC_VEC_SWAP_REMOVE(vec, index)                                                            \
+    ((void)((vec)->data[(index)] = (vec)->data[ccvec_swap_index(&(vec)->base, (index))]))
+
+/// Copies [n] elements from [elements], which can point into [vec], to the end of [vec].
+#define CC_VEC_APPEND(vec, elements, n)                                                           \
+    ccvec_append(&(vec)->base, CC_VEC_ELEM_SIZE(vec), (1 ? (elements) : (vec)->data), (n))
+
+/// Iterates over [vec], whose elements are of type [T], with [it] pointing to each in turn.
+#define CC_VEC_FOREACH(vec, T, it)                                                                \
+    for(T *it = (vec)->data; it != (vec)->data + (vec)->count; ++it)
+
+/// A growable array of pointers.
+typedef CC_VEC(void *) ccarray_t;
+
+/// Initialises [array].
 void ccarray_init(ccarray_t *array);
 
-///
+/// Initialises [array] so that its storage is allocated with [allocator].
+void ccarray_init_with(ccarray_t *array, const cc_allocator_t *allocator);
+
+/// Frees the storage of [array]. The objects it points to are left untouched.
 void ccarray_deinit(ccarray_t *array);
 
-///
+/// Clears [array] and calls [des] on each item in it.
 void ccarray_clear(ccarray_t *array, cc_destructor des, void *ptr);
 
-///
-void ccarray_add_first(ccarray_t *array);
+/// Inserts [item] at the beginning of [array].
+void ccarray_add_first(ccarray_t *array, void *item);
+
+/// Inserts [item] at the end of [array].
+void ccarray_add_last(ccarray_t *array, void *item);
+
+/// Inserts [item] at position [n] in [array].
+void ccarray_insert_at(ccarray_t *array, void *item, size_t n);
 
-///
-void ccarray_add_last(ccarray_t *array);
+/// Removes the item at position [n] from [array], and returns it.
+void *ccarray_remove_at(ccarray_t *array, size_t n);
 
 #ifdef __cplusplus
 } /* extern "C" */
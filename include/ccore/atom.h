@@ -0,0 +1,73 @@
+//===--------------------------------------------------------------------------------------------===
+// atom.h - Interned strings.
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// An interned string. There is exactly one atom per distinct string in the process, so atoms are
+/// compared with ==, and can be used as integer keys by converting them to uintptr_t, or by
+/// hashing them with cc_atom_hash().
+///
+/// Atoms are never freed: their storage comes from an arena that lives as long as the process.
+/// They are meant for identifiers (configuration keys, message names, table keys), not for
+/// arbitrary text.
+typedef const struct cc_atom_s *cc_atom_t;
+
+struct cc_atom_s {
+    uint64_t hash;
+    uint32_t id;
+    uint32_t length;
+    char str[];
+};
+
+/// Returns the atom for [str], interning it if needed. Can be called from any thread; looking up
+/// a string that was already interned never blocks.
+cc_atom_t cc_atom(const char *str);
+
+/// Returns the atom for the [length] characters at [str], interning them if needed.
+cc_atom_t cc_atom_n(const char *str, size_t length);
+
+/// Returns the atom for [str] if it was interned, or NULL. Never interns [str], and never blocks.
+cc_atom_t cc_atom_find(const char *str);
+
+/// Same as cc_atom_find(), with a string of [length] characters.
+cc_atom_t cc_atom_find_n(const char *str, size_t length);
+
+/// Returns the number of atoms interned so far.
+size_t cc_atom_count(void);
+
+/// Returns the NUL-terminated string of [atom].
+static inline const char *cc_atom_str(cc_atom_t atom) {
+    return atom->str;
+}
+
+/// Returns the length of the string of [atom].
+static inline size_t cc_atom_length(cc_atom_t atom) {
+    return atom->length;
+}
+
+/// Returns a hash of [atom], which can be passed as the hash function of CC_MAP_DEFINE(). This is
+/// the cc_hash_bytes() hash of its string, computed once when it was interned.
+static inline uint64_t cc_atom_hash(cc_atom_t atom) {
+    return atom->hash;
+}
+
+/// Returns the id of [atom]. Atoms are numbered from 0 in the order they were interned, so ids
+/// can index dense arrays.
+static inline uint32_t cc_atom_id(cc_atom_t atom) {
+    return atom->id;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
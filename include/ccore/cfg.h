@@ -9,6 +9,7 @@
 #pragma once
 #include <stdbool.h>
 #include <ccore/log.h>
+#include <ccore/memory.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,6 +18,13 @@ extern "C" {
 typedef struct cc_cfg_s cc_cfg_t;
 
 cc_cfg_t *cc_cfg_load(const char *path);
+
+/// Loads the configuration at [path], allocating its entries with [allocator].
+cc_cfg_t *cc_cfg_load_with(const char *path, const cc_allocator_t *allocator);
+
+/// Loads the configuration at [path], allocating all of it from [arena]. The configuration is
+/// freed when [arena] is reset or rewound.
+cc_cfg_t *cc_cfg_load_arena(const char *path, cc_arena_t *arena);
 void cc_cfg_delete(cc_cfg_t *cfg);
 
 bool cc_cfg_key_exists(const cc_cfg_t *cfg, const char *fmt, ...);
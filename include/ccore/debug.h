@@ -16,6 +16,10 @@ extern "C" {
 void cc_print_stack_sw64(PCONTEXT ctx);
 #endif
 void cc_print_stack(int skip_frames);
+
+/// Captures up to [max] return addresses of the calling thread's stack into [frames], skipping
+/// [skip_frames] frames above the caller, and returns the number captured. Does not allocate.
+int cc_capture_stack(void **frames, int max, int skip_frames);
 void cc_except_init(void);
 void cc_except_fini(void);
 
@@ -0,0 +1,76 @@
+//===--------------------------------------------------------------------------------------------===
+// frozen.h - Immutable tables indexed by a minimal perfect hash.
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <ccore/table.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// An entry in a frozen table. Its key is [length] characters at [key_offset] in the key storage
+/// of the table, followed by a NUL character.
+typedef struct ccfrozen_entry_s {
+    uint32_t key_offset;
+    uint32_t length;
+    void *value;
+} ccfrozen_entry_t;
+
+/// A read-only string-indexed table, built once from a cctable_t with cctable_freeze().
+///
+/// Keys are hashed into buckets of a few keys each, and every bucket stores a 32-bit pilot,
+/// picked when the table is built so that the keys of all buckets land on distinct slots. There
+/// are exactly as many slots as keys, so a lookup hashes the key, reads one pilot and compares one
+/// entry. Entries, pilots and keys are stored in a single block.
+///
+/// Frozen tables are never modified once built, so any number of threads can read them without
+/// locking. They do not own their values, which still belong to the table they were built from.
+typedef struct ccfrozen_table_s {
+    size_t size;
+    size_t bucket_count;
+    uint64_t seed;
+    ccfrozen_entry_t *entries;
+    uint32_t *pilots;
+    char *keys;
+    size_t memory_size;
+    const cc_allocator_t *allocator;
+} ccfrozen_table_t;
+
+/// Builds [frozen] from the keys and values of [table], which must be single-valued. Returns false
+/// if no perfect hash could be found, which only happens if two keys have the same 64-bit hash.
+bool cctable_freeze(const cctable_t *table, ccfrozen_table_t *frozen);
+
+/// Same as cctable_freeze(), allocating [frozen] with [allocator].
+bool cctable_freeze_with(
+    const cctable_t *table,
+    ccfrozen_table_t *frozen,
+    const cc_allocator_t *allocator
+);
+
+/// De-initialises [frozen]. Values are not destroyed.
+void ccfrozen_deinit(ccfrozen_table_t *frozen);
+
+/// Retrieves the value mapped to [key] in [frozen], or NULL.
+void *ccfrozen_get(const ccfrozen_table_t *frozen, const char *key);
+
+/// Retrieves the value mapped to the [length] characters at [key] in [frozen], or NULL.
+void *ccfrozen_get_n(const ccfrozen_table_t *frozen, const char *key, size_t length);
+
+/// Returns the key of [entry], which belongs to [frozen].
+static inline const char *ccfrozen_key(
+    const ccfrozen_table_t *frozen,
+    const ccfrozen_entry_t *entry
+) {
+    return frozen->keys + entry->key_offset;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,39 @@
+//===--------------------------------------------------------------------------------------------===
+// hash.h - Non-cryptographic hash functions
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Hashes the [length] bytes at [data], with [seed]. This is a wyhash-style hash that reads input
+/// 8 to 48 bytes at a time; it is fast and well distributed, but not cryptographically secure.
+/// Hashes depend on the byte order of the host, and should not be stored across platforms.
+uint64_t cc_hash_bytes(const void *data, size_t length, uint64_t seed);
+
+/// Hashes the NUL-terminated string [str], with [seed].
+uint64_t cc_hash_str(const char *str, uint64_t seed);
+
+/// Mixes the bits of [x], so that integer keys that differ in a few bits (sequential IDs, aligned
+/// pointers) have unrelated hashes. This is the 64-bit finaliser of MurmurHash3, and is a
+/// bijection: distinct keys never collide.
+static inline uint64_t cc_hash_u64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
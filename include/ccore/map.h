@@ -0,0 +1,318 @@
+//===--------------------------------------------------------------------------------------------===
+// map.h - Hash maps keyed by integers and byte strings.
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <ccore/hash.h>
+#include <ccore/swiss.h>
+#include <ccore/table.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - Integer keys
+
+/// An entry in a ccmap_u64_t. Keys are stored inline, so inserting never allocates a key.
+typedef struct ccmap_u64_entry_s {
+    uint64_t key;
+    void *value;
+} ccmap_u64_entry_t;
+
+/// A single-valued hash map keyed by 64-bit integers. It uses the same index as cctable_t, and
+/// hashes keys with cc_hash_u64().
+typedef struct ccmap_u64_s {
+    size_t size;
+    cchash_index_t index;
+    CC_VEC(ccmap_u64_entry_t) entries;
+} ccmap_u64_t;
+
+/// Initialises [map] with room for [count] keys.
+void ccmap_u64_init(ccmap_u64_t *map, size_t count);
+
+/// Initialises [map] with room for [count] keys, allocating its memory with [allocator].
+void ccmap_u64_init_with(ccmap_u64_t *map, size_t count, const cc_allocator_t *allocator);
+
+/// De-initialises [map] and calls [des] on its values.
+void ccmap_u64_deinit(ccmap_u64_t *map, cc_destructor des, void *user_data);
+
+/// Makes sure [map] can hold at least [count] keys without growing.
+void ccmap_u64_reserve(ccmap_u64_t *map, size_t count);
+
+/// Maps [key] to [value] in [map]. If [key] is already in [map], its value is left unchanged.
+void ccmap_u64_insert(ccmap_u64_t *map, uint64_t key, void *value);
+
+/// Returns a pointer to the value mapped to [key] in [map]. If [key] was not in [map], it is added
+/// with a NULL value, and [inserted] is set to true if it is not NULL. The pointer is valid until
+/// the next insertion.
+void **ccmap_u64_upsert(ccmap_u64_t *map, uint64_t key, bool *inserted);
+
+/// Retrieves the value mapped to [key] in [map], or NULL.
+void *ccmap_u64_get(const ccmap_u64_t *map, uint64_t key);
+
+/// Returns whether [key] is in [map].
+bool ccmap_u64_contains(const ccmap_u64_t *map, uint64_t key);
+
+/// Removes [key] from [map], and calls [des] on its value. Returns false if [key] was not in [map].
+bool ccmap_u64_remove(ccmap_u64_t *map, uint64_t key, cc_destructor des, void *user_data);
+
+/// A cursor over the entries of a ccmap_u64_t, in insertion order.
+typedef struct ccmap_u64_cursor_s {
+    const ccmap_u64_t *map;
+    size_t position;
+} ccmap_u64_cursor_t;
+
+/// Returns a cursor to the first entry in [map].
+ccmap_u64_cursor_t ccmap_u64_cursor(const ccmap_u64_t *map);
+
+/// Returns the entry at [cursor] and moves it forward, or returns NULL at the end of the map. The
+/// entry just returned can be removed while iterating, but inserting invalidates the cursor.
+const ccmap_u64_entry_t *ccmap_u64_next(ccmap_u64_cursor_t *cursor);
+
+// MARK: - Byte string keys
+
+/// A single-valued hash map keyed by arbitrary byte strings, which may contain NUL bytes. This is
+/// a cctable_t that is only ever accessed through the length-aware (_n) functions.
+typedef struct ccmap_bytes_s {
+    cctable_t table;
+} ccmap_bytes_t;
+
+static inline void ccmap_bytes_init(ccmap_bytes_t *map, size_t count) {
+    cctable_init(&map->table, count, false);
+}
+
+static inline void ccmap_bytes_init_with(
+    ccmap_bytes_t *map,
+    size_t count,
+    const cc_allocator_t *allocator
+) {
+    cctable_init_with(&map->table, count, false, allocator);
+}
+
+static inline void ccmap_bytes_deinit(ccmap_bytes_t *map, cc_destructor des, void *user_data) {
+    cctable_deinit(&map->table, des, user_data);
+}
+
+static inline size_t ccmap_bytes_size(const ccmap_bytes_t *map) {
+    return map->table.size;
+}
+
+static inline void ccmap_bytes_reserve(ccmap_bytes_t *map, size_t count) {
+    cctable_reserve(&map->table, count);
+}
+
+/// Maps the [length] bytes at [key] to [value]. The key is copied into [map].
+static inline void ccmap_bytes_insert(
+    ccmap_bytes_t *map,
+    const void *key,
+    size_t length,
+    void *value
+) {
+    cctable_insert_n(&map->table, (const char *)key, length, value);
+}
+
+static inline void **ccmap_bytes_upsert(
+    ccmap_bytes_t *map,
+    const void *key,
+    size_t length,
+    bool *inserted
+) {
+    return cctable_upsert_n(&map->table, (const char *)key, length, inserted);
+}
+
+static inline void *ccmap_bytes_get(const ccmap_bytes_t *map, const void *key, size_t length) {
+    return cctable_get_one_n(&map->table, (const char *)key, length);
+}
+
+static inline bool ccmap_bytes_remove(
+    ccmap_bytes_t *map,
+    const void *key,
+    size_t length,
+    cc_destructor des,
+    void *user_data
+) {
+    return cctable_remove_n(&map->table, (const char *)key, length, des, user_data);
+}
+
+// MARK: - Generated maps
+
+/// Compares two keys with ==. Can be passed as the [eq_fn] of CC_MAP_DEFINE() for scalar keys.
+#define CC_MAP_EQ(a, b) ((a) == (b))
+
+/// Defines [name]_t, a hash map from [K] to [V], and the static inline functions that operate on
+/// it. [hash_fn] is called as hash_fn(key) and returns a 64-bit hash; [eq_fn] is called as
+/// eq_fn(a, b) with two keys. Both can be macros, and since every function is generated for the
+/// key and value types, hashing and comparison are inlined into lookups.
+///
+/// Keys and values are stored by value in the slots of the map, so [V] can be any type, and
+/// pointers returned by lookups stay valid until the next insertion. Unlike cctable_t, the map
+/// grows all at once, rehashing every entry, and iteration is in slot order.
+///
+///     CC_MAP_DEFINE(idmap, uint64_t, vec3_t, cc_hash_u64, CC_MAP_EQ)
+///
+/// defines idmap_entry_t, idmap_t and:
+///
+/// - idmap_init(map, count) and idmap_init_with(map, count, allocator);
+/// - idmap_deinit(map), idmap_clear(map) and idmap_reserve(map, count);
+/// - V *idmap_get(map, key), which returns NULL if [key] is not in the map;
+/// - bool idmap_contains(map, key);
+/// - V *idmap_upsert(map, key, inserted), which adds [key] with a zeroed value if needed;
+/// - bool idmap_insert(map, key, value), which returns false and keeps the existing value if
+///   [key] was already in the map;
+/// - bool idmap_remove(map, key, value), which copies the removed value to [value] if it is not
+///   NULL;
+/// - idmap_entry_t *idmap_next(map, &it), which iterates from it = 0 until it returns NULL.
+///   Entries can be removed while iterating, but inserting invalidates the iteration.
+#define CC_MAP_DEFINE(name, K, V, hash_fn, eq_fn)                                                  \
+    typedef struct name##_entry_s {                                                                \
+        K key;                                                                                     \
+        V value;                                                                                   \
+    } name##_entry_t;                                                                              \
+                                                                                                   \
+    typedef struct name##_s {                                                                      \
+        size_t size;                                                                               \
+        size_t used;                                                                               \
+        size_t capacity;                                                                           \
+        uint8_t *ctrl;                                                                             \
+        name##_entry_t *entries;                                                                   \
+        const cc_allocator_t *allocator;                                                           \
+    } name##_t;                                                                                    \
+                                                                                                   \
+    static inline size_t name##_alloc_size(size_t capacity) {                                      \
+        return capacity * sizeof(name##_entry_t) + capacity + CC_SWISS_GROUP_SIZE;                 \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_alloc(name##_t *map, size_t capacity) {                              \
+        map->size = 0;                                                                             \
+        map->used = 0;                                                                             \
+        map->capacity = capacity;                                                                  \
+        size_t size = name##_alloc_size(capacity);                                                 \
+        map->entries = (name##_entry_t *)cc_alloc_with(map->allocator, size);                      \
+        map->ctrl = (uint8_t *)(map->entries + capacity);                                          \
+        memset(map->ctrl, CC_SWISS_EMPTY, capacity + CC_SWISS_GROUP_SIZE);                         \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_init_with(                                                           \
+        name##_t *map,                                                                             \
+        size_t count,                                                                              \
+        const cc_allocator_t *allocator                                                            \
+    ) {                                                                                            \
+        map->allocator = allocator;                                                                \
+        name##_alloc(map, ccswiss_capacity_for(count));                                            \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_init(name##_t *map, size_t count) {                                  \
+        name##_init_with(map, count, NULL);                                                        \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_deinit(name##_t *map) {                                              \
+        cc_free_with(map->allocator, map->entries, name##_alloc_size(map->capacity));              \
+        map->entries = NULL;                                                                       \
+        map->ctrl = NULL;                                                                          \
+        map->size = map->used = map->capacity = 0;                                                 \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_clear(name##_t *map) {                                               \
+        memset(map->ctrl, CC_SWISS_EMPTY, map->capacity + CC_SWISS_GROUP_SIZE);                    \
+        map->size = map->used = 0;                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    static inline size_t name##_find(const name##_t *map, K key, size_t hash) {                    \
+        uint8_t h2 = ccswiss_h2(hash);                                                             \
+        ccswiss_probe_t probe = ccswiss_probe_start(hash, map->capacity);                          \
+        for(;;) {                                                                                  \
+            const uint8_t *group = map->ctrl + probe.pos;                                          \
+            for(ccswiss_mask_t match = ccswiss_match(group, h2); match; match &= match - 1) {      \
+                size_t slot = ccswiss_probe_slot(&probe, ccswiss_first(match));                    \
+                if(eq_fn(map->entries[slot].key, key)) return slot;                                \
+            }                                                                                      \
+            if(ccswiss_match_empty(group)) return SIZE_MAX;                                        \
+            ccswiss_probe_next(&probe);                                                            \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static inline name##_entry_t *name##_put(name##_t *map, K key, size_t hash) {                  \
+        size_t slot = ccswiss_find_free(map->ctrl, map->capacity, hash);                           \
+        if(map->ctrl[slot] == CC_SWISS_EMPTY) map->used += 1;                                      \
+        ccswiss_set_ctrl(map->ctrl, map->capacity, slot, ccswiss_h2(hash));                        \
+        map->size += 1;                                                                            \
+        map->entries[slot].key = key;                                                              \
+        return &map->entries[slot];                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_rehash(name##_t *map, size_t capacity) {                             \
+        name##_t old = *map;                                                                       \
+        name##_alloc(map, capacity);                                                               \
+        for(size_t i = 0; i < old.capacity; ++i) {                                                 \
+            if(!ccswiss_is_full(old.ctrl[i])) continue;                                            \
+            K key = old.entries[i].key;                                                            \
+            name##_entry_t *entry = name##_put(map, key, hash_fn(key));                            \
+            memcpy(&entry->value, &old.entries[i].value, sizeof(V));                               \
+        }                                                                                          \
+        cc_free_with(old.allocator, old.entries, name##_alloc_size(old.capacity));                 \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_reserve(name##_t *map, size_t count) {                               \
+        size_t capacity = ccswiss_capacity_for(count);                                             \
+        if(capacity > map->capacity) name##_rehash(map, capacity);                                 \
+    }                                                                                              \
+                                                                                                   \
+    static inline V *name##_get(const name##_t *map, K key) {                                      \
+        size_t slot = name##_find(map, key, hash_fn(key));                                         \
+        return slot != SIZE_MAX ? &map->entries[slot].value : NULL;                                \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_contains(const name##_t *map, K key) {                               \
+        return name##_find(map, key, hash_fn(key)) != SIZE_MAX;                                    \
+    }                                                                                              \
+                                                                                                   \
+    static inline V *name##_upsert(name##_t *map, K key, bool *inserted) {                         \
+        size_t hash = hash_fn(key);                                                                \
+        size_t slot = name##_find(map, key, hash);                                                 \
+        if(inserted) *inserted = slot == SIZE_MAX;                                                 \
+        if(slot != SIZE_MAX) return &map->entries[slot].value;                                     \
+        /* Deleted slots count towards the load, so a map that is mostly tombstones is rebuilt */  \
+        /* at the same capacity instead of growing. */                                             \
+        if(map->used + 1 > CC_SWISS_MAX_LOAD(map->capacity)) {                                     \
+            bool grow = map->size + 1 > CC_SWISS_MAX_LOAD(map->capacity) / 2;                      \
+            name##_rehash(map, grow ? map->capacity * 2 : map->capacity);                          \
+        }                                                                                          \
+        name##_entry_t *entry = name##_put(map, key, hash);                                        \
+        memset(&entry->value, 0, sizeof(V));                                                       \
+        return &entry->value;                                                                      \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_insert(name##_t *map, K key, V value) {                              \
+        bool inserted;                                                                             \
+        V *slot = name##_upsert(map, key, &inserted);                                              \
+        if(inserted) *slot = value;                                                                \
+        return inserted;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_remove(name##_t *map, K key, V *value) {                             \
+        size_t slot = name##_find(map, key, hash_fn(key));                                         \
+        if(slot == SIZE_MAX) return false;                                                         \
+        if(value) *value = map->entries[slot].value;                                               \
+        ccswiss_set_ctrl(map->ctrl, map->capacity, slot, CC_SWISS_DELETED);                        \
+        map->size -= 1;                                                                            \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline name##_entry_t *name##_next(const name##_t *map, size_t *it) {                   \
+        while(*it < map->capacity) {                                                               \
+            size_t slot = (*it)++;                                                                 \
+            if(ccswiss_is_full(map->ctrl[slot])) return &map->entries[slot];                       \
+        }                                                                                          \
+        return NULL;                                                                               \
+    }
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -7,7 +7,9 @@
 // =^•.•^=
 //===--------------------------------------------------------------------------------------------===
 #pragma once
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,7 +23,9 @@ typedef void (*cc_destructor)(void *, void *);
 
 extern void cc_default_destructor(void *ptr, void *);
 
-/// Installs a custom memory allocation function for c-core function.
+/// Installs a custom memory allocation function for c-core function. When ccore is built with the
+/// thread-local cache (CCORE_TCACHE), the allocator must be installed before any allocation, and
+/// small blocks are served from the cache, which obtains its memory from [allocator].
 void cc_set_allocator(cc_allocator allocator);
 
 /// Allocates [bytes] of memory and returns a pointer to it.
@@ -33,6 +37,264 @@ void cc_free(void *ptr);
 /// Grows or shrink the memory at [ptr] so that at least [size] bytes are available.
 void *cc_realloc(void *ptr, size_t size);
 
+/// Allocates [size] bytes, attributing the allocation to [file]:[line] in the statistics.
+void *cc_alloc_site(size_t size, const char *file, int line);
+
+/// Resizes [ptr], attributing the new allocation to [file]:[line] in the statistics.
+void *cc_realloc_site(void *ptr, size_t size, const char *file, int line);
+
+#ifdef CC_MEM_SITES
+#define cc_alloc(size) cc_alloc_site((size), __FILE__, __LINE__)
+#define cc_realloc(ptr, size) cc_realloc_site((ptr), (size), __FILE__, __LINE__)
+#endif
+
+/// The number of buckets in the allocation size histogram. Bucket [n] counts allocations of
+/// [2^n, 2^(n+1)) bytes, and the last bucket counts everything larger.
+#define CC_MEM_HISTOGRAM_BUCKETS (32)
+
+/// The maximum number of distinct call sites tracked. Must be a power of two.
+#define CC_MEM_MAX_SITES (4096)
+
+/// Allocation statistics, collected when ccore is built with CCORE_MEM_STATS.
+typedef struct cc_mem_stats_s {
+    size_t live_bytes;
+    size_t peak_bytes;
+    size_t live_blocks;
+    uint64_t allocs;
+    uint64_t reallocs;
+    uint64_t frees;
+    uint64_t histogram[CC_MEM_HISTOGRAM_BUCKETS];
+} cc_mem_stats_t;
+
+/// Allocation statistics for a single call site, collected when ccore is built with
+/// CCORE_MEM_SITES.
+typedef struct cc_mem_site_s {
+    const char *file;
+    int line;
+    size_t live_bytes;
+    size_t live_blocks;
+    uint64_t allocs;
+    uint64_t total_bytes;
+} cc_mem_site_t;
+
+/// Fills [out] with the current allocation statistics. Returns false if statistics are disabled.
+bool cc_mem_stats(cc_mem_stats_t *out);
+
+/// Fills [out] with up to [max] call sites, sorted by live bytes, and returns how many were
+/// written. Returns 0 if per-call-site statistics are disabled.
+size_t cc_mem_sites(cc_mem_site_t *out, size_t max);
+
+/// Prints the allocation statistics and the top call sites with cc_printf().
+void cc_mem_dump(void);
+
+/// The deepest stack recorded for a heap profile sample.
+#define CC_HEAP_PROFILE_MAX_DEPTH (32)
+
+/// The maximum number of live samples the heap profiler keeps. Must be a power of two.
+#define CC_HEAP_PROFILE_MAX_SAMPLES (8192)
+
+/// Starts the sampling heap profiler. On average, one allocation every [period] bytes allocated
+/// through cc_alloc() has its stack recorded, and stays in the profile until it is freed.
+void cc_heap_profile_start(size_t period);
+
+/// Stops sampling new allocations. Samples that are still live are kept until they are freed.
+void cc_heap_profile_stop(void);
+
+/// Writes the live samples to [path] as folded stacks ("root;caller;callee bytes"), which can be
+/// fed to flamegraph.pl, speedscope and the like. Sizes are scaled to estimate total bytes.
+bool cc_heap_profile_write(const char *path);
+
+/// Writes the heap profile to [path] when the process exits. [path] is copied, and replaces the
+/// path given by any earlier call.
+void cc_heap_profile_write_at_exit(const char *path);
+
+/// A stateful allocator. Unlike cc_allocator, it carries a context pointer, and is told the size
+/// of the blocks it reallocates and frees, so it doesn't need to store per-allocation headers.
+/// Containers that accept an allocator fall back to cc_alloc() and friends when given NULL.
+typedef struct cc_allocator_s {
+    void *(*alloc)(void *ctx, size_t size);
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t size);
+    void (*free)(void *ctx, void *ptr, size_t size);
+    void *ctx;
+} cc_allocator_t;
+
+/// Returns an allocator that forwards to cc_alloc(), cc_realloc() and cc_free().
+const cc_allocator_t *cc_default_allocator(void);
+
+/// Allocates [size] bytes using [allocator], or cc_alloc() if [allocator] is NULL.
+static inline void *(cc_alloc_with)(const cc_allocator_t *allocator, size_t size) {
+    if(!allocator) return (cc_alloc)(size);
+    return allocator->alloc(allocator->ctx, size);
+}
+
+/// Resizes the [old_size]-byte block at [ptr] using [allocator], or cc_realloc() if NULL.
+static inline void *(cc_realloc_with)(
+    const cc_allocator_t *allocator,
+    void *ptr,
+    size_t old_size,
+    size_t size
+) {
+    if(!allocator) return (cc_realloc)(ptr, size);
+    return allocator->realloc(allocator->ctx, ptr, old_size, size);
+}
+
+#ifdef CC_MEM_SITES
+static inline void *cc_alloc_with_site(
+    const cc_allocator_t *allocator,
+    size_t size,
+    const char *file,
+    int line
+) {
+    if(!allocator) return cc_alloc_site(size, file, line);
+    return allocator->alloc(allocator->ctx, size);
+}
+
+static inline void *cc_realloc_with_site(
+    const cc_allocator_t *allocator,
+    void *ptr,
+    size_t old_size,
+    size_t size,
+    const char *file,
+    int line
+) {
+    if(!allocator) return cc_realloc_site(ptr, size, file, line);
+    return allocator->realloc(allocator->ctx, ptr, old_size, size);
+}
+
+#define cc_alloc_with(allocator, size) \
+    cc_alloc_with_site((allocator), (size), __FILE__, __LINE__)
+#define cc_realloc_with(allocator, ptr, old_size, size) \
+    cc_realloc_with_site((allocator), (ptr), (old_size), (size), __FILE__, __LINE__)
+#endif
+
+/// Frees the [size]-byte block at [ptr] using [allocator], or cc_free() if NULL.
+static inline void cc_free_with(const cc_allocator_t *allocator, void *ptr, size_t size) {
+    if(!ptr) return;
+    if(!allocator) return cc_free(ptr);
+    allocator->free(allocator->ctx, ptr, size);
+}
+
+/// The assumed size of a cache line on the target platform.
+#define CC_CACHE_LINE_SIZE (64)
+
+/// The granularity of cc_alloc_pages().
+#define CC_PAGE_SIZE (4096)
+
+/// The size of a (transparent) huge page. Page allocations of at least this size are aligned to it.
+#define CC_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/// Allocates [size] bytes aligned to [align], which must be a power of two.
+void *cc_alloc_aligned(size_t size, size_t align);
+
+/// Frees memory allocated with cc_alloc_aligned().
+void cc_free_aligned(void *ptr);
+
+/// Allocates [size] bytes aligned to [align] using [allocator], or cc_alloc() if NULL.
+void *cc_alloc_aligned_with(const cc_allocator_t *allocator, size_t size, size_t align);
+
+/// Frees memory allocated with cc_alloc_aligned_with(). [size] and [align] must match the values
+/// the block was allocated with.
+void cc_free_aligned_with(const cc_allocator_t *allocator, void *ptr, size_t size, size_t align);
+
+/// Maps [size] bytes of zeroed memory directly from the operating system, for large buffers.
+/// Buffers of at least CC_HUGE_PAGE_SIZE are huge page-aligned, and backed by transparent huge
+/// pages where the system supports them, which cuts down on TLB misses.
+void *cc_alloc_pages(size_t size);
+
+/// Unmaps a buffer of [size] bytes allocated with cc_alloc_pages().
+void cc_free_pages(void *ptr, size_t size);
+
+/// The size of the chunks allocated by an arena, unless specified otherwise.
+#define CC_ARENA_DEFAULT_CHUNK_SIZE (16 * 1024)
+
+typedef struct cc_arena_chunk_s cc_arena_chunk_t;
+
+/// A bump allocator. Memory is carved out of large chunks obtained from a parent allocator, and
+/// cannot be freed piecemeal: the whole arena is either reset, or rewound to a previously taken
+/// mark. Chunks are kept until the arena is de-initialised, so a reset arena never allocates.
+typedef struct cc_arena_s {
+    cc_arena_chunk_t *first;
+    cc_arena_chunk_t *current;
+    size_t chunk_size;
+    const cc_allocator_t *parent;
+    cc_allocator_t allocator;
+} cc_arena_t;
+
+/// A position in an arena that the arena can later be rewound to.
+typedef struct cc_arena_mark_s {
+    cc_arena_chunk_t *chunk;
+    size_t used;
+} cc_arena_mark_t;
+
+/// Allocates an object of type [T] in [arena].
+#define CC_ARENA_NEW(arena, T) ((T *)cc_arena_alloc((arena), sizeof(T)))
+
+/// Initialises [arena]. Chunks will be [chunk_size] bytes, or CC_ARENA_DEFAULT_CHUNK_SIZE if 0.
+void cc_arena_init(cc_arena_t *arena, size_t chunk_size);
+
+/// Initialises [arena] so that its chunks are allocated with [parent].
+void cc_arena_init_with(cc_arena_t *arena, size_t chunk_size, const cc_allocator_t *parent);
+
+/// Returns an allocator that allocates from [arena]. Freeing is a no-op, unless the block is the
+/// last one allocated from [arena], in which case its memory is reclaimed.
+const cc_allocator_t *cc_arena_allocator(cc_arena_t *arena);
+
+/// Frees all the memory held by [arena]. Pointers allocated from it become invalid.
+void cc_arena_deinit(cc_arena_t *arena);
+
+/// Allocates [size] bytes from [arena]. The memory is suitably aligned for any type.
+void *cc_arena_alloc(cc_arena_t *arena, size_t size);
+
+/// Resizes [ptr], which was allocated from [arena] with [old_size] bytes. If [ptr] is the last
+/// allocation made from [arena], it is grown or shrunk in place when possible.
+void *cc_arena_realloc(cc_arena_t *arena, void *ptr, size_t old_size, size_t size);
+
+/// Returns the current position of [arena].
+cc_arena_mark_t cc_arena_mark(const cc_arena_t *arena);
+
+/// Frees everything allocated from [arena] since [mark] was taken.
+void cc_arena_rewind(cc_arena_t *arena, cc_arena_mark_t mark);
+
+/// Frees everything allocated from [arena], in constant time. Chunks are kept for reuse.
+void cc_arena_reset(cc_arena_t *arena);
+
+/// The size past which pool slabs stop growing.
+#define CC_POOL_MAX_SLAB_SIZE (64 * 1024)
+
+typedef struct cc_pool_slab_s cc_pool_slab_t;
+
+/// A slab allocator for objects of a single size. Objects are carved out of cache line-aligned
+/// slabs that grow geometrically, and freed objects are kept in a free list for reuse. A pool is
+/// not thread-safe: callers that share one between threads must serialise access to it.
+typedef struct cc_pool_s {
+    const cc_allocator_t *allocator;
+    size_t object_size;
+    size_t slab_capacity;
+    void *free_list;
+    unsigned char *bump;
+    unsigned char *bump_end;
+    cc_pool_slab_t *slabs;
+} cc_pool_t;
+
+/// Allocates an object of type [T] from [pool].
+#define CC_POOL_NEW(pool, T) ((T *)cc_pool_alloc((pool)))
+
+/// Initialises [pool] to allocate objects of [object_size] bytes. No memory is allocated until
+/// the first call to cc_pool_alloc().
+void cc_pool_init(cc_pool_t *pool, size_t object_size);
+
+/// Initialises [pool] so that its slabs are allocated with [allocator].
+void cc_pool_init_with(cc_pool_t *pool, size_t object_size, const cc_allocator_t *allocator);
+
+/// Frees all the slabs held by [pool] at once. Objects allocated from it become invalid.
+void cc_pool_deinit(cc_pool_t *pool);
+
+/// Allocates an object from [pool].
+void *cc_pool_alloc(cc_pool_t *pool);
+
+/// Returns [ptr] to [pool]. [ptr] must have been allocated from [pool].
+void cc_pool_free(cc_pool_t *pool, void *ptr);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
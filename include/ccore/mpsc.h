@@ -0,0 +1,61 @@
+//===--------------------------------------------------------------------------------------------===
+// mpsc.h - Lock-free intrusive multi-producer, single-consumer queue
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <ccore/list.h>
+#include <ccore/memory.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// An intrusive queue that any number of threads can push objects to, and a single thread pops
+/// them from, in the order they were pushed. Like with cclist_t, objects embed a cclist_node_t at
+/// [offset]; only its [next] link is used, and an object can be in one queue at a time.
+///
+/// Pushing is wait-free and never allocates. The consumer never blocks either: while a producer is
+/// in the middle of pushing, the objects behind it are not visible yet, and are found by the
+/// next pop or drain. The queue points into itself, so it cannot be copied or moved once
+/// initialised.
+typedef struct ccmpsc_s {
+    cclist_node_t *head;
+    char head_padding[CC_CACHE_LINE_SIZE - sizeof(cclist_node_t *)];
+    cclist_node_t *tail;
+    cclist_node_t stub;
+    size_t offset;
+} ccmpsc_t;
+
+/// A function called on each object drained from a queue.
+typedef void (*ccmpsc_callback_f)(void *object, void *user_data);
+
+/// Initialises an empty [queue] of objects that embed a cclist_node_t at [offset].
+void ccmpsc_init(ccmpsc_t *queue, size_t offset);
+
+/// Pushes [object] at the back of [queue]. Can be called from any thread.
+void ccmpsc_push(ccmpsc_t *queue, void *object);
+
+/// Removes and returns the object at the front of [queue], or returns NULL if there is none yet.
+/// Must only be called from the consumer thread.
+void *ccmpsc_pop(ccmpsc_t *queue);
+
+/// Pops up to [max] objects from [queue] and calls [fn] on each of them, in order, with
+/// [user_data]. Returns the number of objects drained. Objects pushed while draining are drained
+/// too, so a bounded [max] keeps busy producers from holding the consumer forever; pass SIZE_MAX to
+/// drain everything. [fn] can free the object or push it back. Must only be called from the
+/// consumer thread.
+size_t ccmpsc_drain(ccmpsc_t *queue, size_t max, ccmpsc_callback_f fn, void *user_data);
+
+/// Returns whether [queue] looks empty. Objects being pushed concurrently may not be counted, so
+/// this is only a hint unless all producers have stopped.
+bool ccmpsc_is_empty(const ccmpsc_t *queue);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
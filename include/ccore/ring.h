@@ -0,0 +1,102 @@
+//===--------------------------------------------------------------------------------------------===
+// ring.h - Contiguous growable ring buffer/double-ended queue
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <ccore/memory.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// A double-ended queue of fixed-size elements, stored in a power-of-two ring buffer that grows
+/// when it is full. Elements are copied in and out of the ring, so no allocation happens per
+/// element.
+typedef struct ccring_s {
+    unsigned char *data;
+    size_t elem_size;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    const cc_allocator_t *allocator;
+} ccring_t;
+
+/// Initialises [ring] to hold elements of [elem_size] bytes.
+void ccring_init(ccring_t *ring, size_t elem_size);
+
+/// Initialises [ring] so that its storage is allocated with [allocator].
+void ccring_init_with(ccring_t *ring, size_t elem_size, const cc_allocator_t *allocator);
+
+/// Frees the storage of [ring].
+void ccring_deinit(ccring_t *ring);
+
+/// Removes every element from [ring], but keeps its storage.
+void ccring_clear(ccring_t *ring);
+
+/// Makes sure [ring] can hold at least [capacity] elements without growing. The actual capacity
+/// is rounded up to a power of two.
+void ccring_reserve(ccring_t *ring, size_t capacity);
+
+/// Copies [elem] to the back of [ring].
+void ccring_push_back(ccring_t *ring, const void *elem);
+
+/// Copies [elem] to the front of [ring].
+void ccring_push_front(ccring_t *ring, const void *elem);
+
+/// Copies [elem] to the back of [ring], dropping the front element instead of growing when the
+/// ring is full. Used with ccring_reserve(), this keeps a history of the latest elements.
+void ccring_push_back_overwrite(ccring_t *ring, const void *elem);
+
+/// Removes the front element of [ring], and copies it to [out] unless it is NULL. Returns false
+/// if [ring] is empty.
+bool ccring_pop_front(ccring_t *ring, void *out);
+
+/// Removes the back element of [ring], and copies it to [out] unless it is NULL. Returns false
+/// if [ring] is empty.
+bool ccring_pop_back(ccring_t *ring, void *out);
+
+/// Copies [count] elements from [elems] to the back of [ring].
+void ccring_write(ccring_t *ring, const void *elems, size_t count);
+
+/// Removes up to [count] elements from the front of [ring] and copies them to [out]. Returns the
+/// number of elements read.
+size_t ccring_read(ccring_t *ring, void *out, size_t count);
+
+/// Copies up to [count] elements starting at [index] to [out], without removing them. Returns
+/// the number of elements copied.
+size_t ccring_copy(const ccring_t *ring, size_t index, void *out, size_t count);
+
+/// Returns the number of elements in [ring].
+static inline size_t ccring_count(const ccring_t *ring) {
+    return ring->count;
+}
+
+/// Returns whether [ring] is empty.
+static inline bool ccring_empty(const ccring_t *ring) {
+    return !ring->count;
+}
+
+/// Returns a pointer to the element at [index] in [ring], counting from the front.
+static inline void *ccring_at(const ccring_t *ring, size_t index) {
+    return ring->data + ((ring->head + index) & (ring->capacity - 1)) * ring->elem_size;
+}
+
+/// Returns a pointer to the front element of [ring], or NULL if it is empty.
+static inline void *ccring_front(const ccring_t *ring) {
+    return ring->count ? ccring_at(ring, 0) : NULL;
+}
+
+/// Returns a pointer to the back element of [ring], or NULL if it is empty.
+static inline void *ccring_back(const ccring_t *ring) {
+    return ring->count ? ccring_at(ring, ring->count - 1) : NULL;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
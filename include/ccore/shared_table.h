@@ -0,0 +1,71 @@
+//===--------------------------------------------------------------------------------------------===
+// shared_table.h - Concurrent string-indexed hash table.
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <ccore/memory.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// A single-valued, string-indexed hash table that can be used from several threads at once,
+/// without external locking.
+///
+/// Keys are spread over shards, each with its own lock, so writers only contend when they hit the
+/// same shard. Lookups never take a lock: they are protected by epochs, and memory unlinked by
+/// writers (removed entries, and the slots of a shard that grew) is only freed once no lookup can
+/// still be reading it.
+///
+/// The table only owns its keys. A value returned by a lookup can be removed from the table by
+/// another thread at any time, so callers must manage the lifetime of values themselves.
+typedef struct ccshared_table_s {
+    size_t shard_count;
+    struct ccshared_shard_s *shards;
+} ccshared_table_t;
+
+/// Initialises [table] with room for [count] keys. [shards] is rounded up to a power of two; a
+/// few times the number of writing threads keeps contention low. 0 picks a default.
+void ccshared_table_init(ccshared_table_t *table, size_t count, size_t shards);
+
+/// De-initialises [table] and calls [des] on its values. No other thread may use [table].
+void ccshared_table_deinit(ccshared_table_t *table, cc_destructor des, void *user_data);
+
+/// Returns the number of keys in [table]. While other threads write to [table], this is only an
+/// estimate.
+size_t ccshared_table_size(const ccshared_table_t *table);
+
+/// Maps [key] to [value] in [table], and returns true. If [key] is already in [table], its value
+/// is left unchanged and false is returned.
+bool ccshared_table_insert(ccshared_table_t *table, const char *key, void *value);
+
+/// Same as ccshared_table_insert(), with a key of [length] characters.
+bool ccshared_table_insert_n(ccshared_table_t *table, const char *key, size_t length, void *value);
+
+/// Retrieves the value mapped to [key] in [table], or NULL. Never blocks.
+void *ccshared_table_get(const ccshared_table_t *table, const char *key);
+
+/// Same as ccshared_table_get(), with a key of [length] characters.
+void *ccshared_table_get_n(const ccshared_table_t *table, const char *key, size_t length);
+
+/// Removes [key] from [table], and stores the value it was mapped to in [value] if it is not
+/// NULL. Returns false if [key] was not in [table].
+bool ccshared_table_remove(ccshared_table_t *table, const char *key, void **value);
+
+/// Same as ccshared_table_remove(), with a key of [length] characters.
+bool ccshared_table_remove_n(
+    ccshared_table_t *table,
+    const char *key,
+    size_t length,
+    void **value
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
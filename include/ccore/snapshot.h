@@ -0,0 +1,76 @@
+//===--------------------------------------------------------------------------------------------===
+// snapshot.h - Memory-mapped, read-only table snapshots.
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <ccore/table.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The version of the snapshot format written by this version of ccore. Snapshots with another
+/// version are rejected when opened.
+#define CCSNAPSHOT_VERSION (1)
+
+/// A snapshot of a single-valued cctable_t, mapped read-only from a file.
+///
+/// Snapshots only contain offsets, so they are used in place: opening one maps the file and
+/// checks its header, without reading or parsing the rest. Lookups go through the same minimal
+/// perfect hash as ccfrozen_table_t, and only touch the pages they need. Since the mapping is
+/// shared and read-only, processes that open the same snapshot share its pages.
+///
+/// Snapshots store keys and values in host byte order, and hashes depend on it too: a snapshot
+/// written on a little-endian machine is rejected on a big-endian one.
+typedef struct ccsnapshot_s {
+    const unsigned char *data;
+    size_t data_size;
+} ccsnapshot_t;
+
+/// Returns the bytes to store for [value] in a snapshot, and sets [size] to their count.
+typedef const void *(*ccsnapshot_value_f)(const void *value, size_t *size, void *user_data);
+
+/// Writes a snapshot of [table], which must be single-valued, to [path]. Values are stored as the
+/// bytes returned by [value_bytes], called with [user_data]. If [value_bytes] is NULL, the value
+/// pointers themselves are stored, as 8-byte integers, which suits tables that map keys to
+/// integers or indices. The snapshot is written to a temporary file that then replaces [path], so
+/// processes that have the old snapshot open are not affected. On Windows, a file cannot be
+/// replaced while it is mapped: this fails if any process still has the old snapshot open.
+bool cctable_write_snapshot(
+    const cctable_t *table,
+    const char *path,
+    ccsnapshot_value_f value_bytes,
+    void *user_data
+);
+
+/// Maps the snapshot at [path] into [snapshot]. Returns false if the file cannot be mapped, or is
+/// not a valid snapshot for this version and machine.
+bool ccsnapshot_open(ccsnapshot_t *snapshot, const char *path);
+
+/// Unmaps [snapshot]. Pointers returned by lookups become invalid.
+void ccsnapshot_close(ccsnapshot_t *snapshot);
+
+/// Returns the number of keys in [snapshot].
+size_t ccsnapshot_size(const ccsnapshot_t *snapshot);
+
+/// Returns the value bytes stored for [key] in [snapshot] and sets [size] to their count if it
+/// is not NULL, or returns NULL. Values are 8-byte aligned in the mapping.
+const void *ccsnapshot_get(const ccsnapshot_t *snapshot, const char *key, size_t *size);
+
+/// Same as ccsnapshot_get(), with a key of [length] characters.
+const void *ccsnapshot_get_n(
+    const ccsnapshot_t *snapshot,
+    const char *key,
+    size_t length,
+    size_t *size
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
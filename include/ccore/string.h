@@ -74,6 +74,21 @@ char *string_duplicate(const char *str) {
     return dup;
 }
 
+static inline
+char *string_duplicate_with(const char *str, const cc_allocator_t *allocator) {
+    CCASSERT(str);
+    size_t size = strlen(str) + 1;
+    char *dup = cc_alloc_with(allocator, size);
+    memcpy(dup, str, size);
+    return dup;
+}
+
+static inline
+char *string_duplicate_arena(const char *str, cc_arena_t *arena) {
+    CCASSERT(arena);
+    return string_duplicate_with(str, cc_arena_allocator(arena));
+}
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,165 @@
+//===--------------------------------------------------------------------------------------------===
+// swiss.h - Open-addressing control bytes and group probing.
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_SWISS_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define CC_SWISS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Building blocks for the open-addressing ("Swiss table") indices used by ccore's hash maps.
+/// They are public so that maps generated by CC_MAP_DEFINE() can be fully inlined.
+///
+/// Each slot in an index has a control byte. Full slots store the low 7 bits of their hash (H2),
+/// so a group of 16 slots can be matched against a key with a single vector compare. Empty and
+/// deleted slots have their top bit set.
+#define CC_SWISS_EMPTY ((uint8_t)0x80)
+#define CC_SWISS_DELETED ((uint8_t)0xfe)
+#define CC_SWISS_GROUP_SIZE (16)
+#define CC_SWISS_MIN_CAPACITY (CC_SWISS_GROUP_SIZE)
+
+/// Indices are kept at most 7/8 full, so that probe sequences stay short and always find an empty
+/// slot.
+#define CC_SWISS_MAX_LOAD(capacity) ((capacity) - (capacity) / 8)
+
+typedef uint32_t ccswiss_mask_t;
+
+static inline uint8_t ccswiss_h2(size_t hash) {
+    return hash & 0x7f;
+}
+
+static inline size_t ccswiss_h1(size_t hash) {
+    return hash >> 7;
+}
+
+static inline bool ccswiss_is_full(uint8_t ctrl) {
+    return !(ctrl & 0x80);
+}
+
+/// Returns the power-of-two capacity an index needs to hold [count] entries.
+static inline size_t ccswiss_capacity_for(size_t count) {
+    size_t v = count + count / 7;
+#if SIZE_MAX > UINT32_MAX
+    v |= v >> 32;
+#endif
+    v |= v >> 16;
+    v |= v >> 8;
+    v |= v >> 4;
+    v |= v >> 2;
+    v |= v >> 1;
+    v += 1;
+    return v < CC_SWISS_MIN_CAPACITY ? CC_SWISS_MIN_CAPACITY : v;
+}
+
+#if CC_SWISS_SSE2
+
+static inline ccswiss_mask_t ccswiss_match(const uint8_t *group, uint8_t h2) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
+}
+
+static inline ccswiss_mask_t ccswiss_match_free(const uint8_t *group) {
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+
+#elif CC_SWISS_NEON
+
+static inline ccswiss_mask_t ccswiss_movemask(uint8x16_t cmp) {
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t masked = vandq_u8(cmp, vld1q_u8(bits));
+    return vaddv_u8(vget_low_u8(masked)) | (vaddv_u8(vget_high_u8(masked)) << 8);
+}
+
+static inline ccswiss_mask_t ccswiss_match(const uint8_t *group, uint8_t h2) {
+    return ccswiss_movemask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(h2)));
+}
+
+static inline ccswiss_mask_t ccswiss_match_free(const uint8_t *group) {
+    return ccswiss_movemask(vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(group))));
+}
+
+#else
+
+static inline ccswiss_mask_t ccswiss_match(const uint8_t *group, uint8_t h2) {
+    ccswiss_mask_t mask = 0;
+    for(int i = 0; i < CC_SWISS_GROUP_SIZE; ++i) {
+        if(group[i] == h2) mask |= 1u << i;
+    }
+    return mask;
+}
+
+static inline ccswiss_mask_t ccswiss_match_free(const uint8_t *group) {
+    ccswiss_mask_t mask = 0;
+    for(int i = 0; i < CC_SWISS_GROUP_SIZE; ++i) {
+        if(group[i] & 0x80) mask |= 1u << i;
+    }
+    return mask;
+}
+
+#endif
+
+/// Returns a mask of the empty slots in [group].
+static inline ccswiss_mask_t ccswiss_match_empty(const uint8_t *group) {
+    return ccswiss_match(group, CC_SWISS_EMPTY);
+}
+
+static inline int ccswiss_first(ccswiss_mask_t mask) {
+    return __builtin_ctz(mask);
+}
+
+/// Probe sequences visit groups at triangular offsets, which covers every group of a power-of-two
+/// index. The control array has CC_SWISS_GROUP_SIZE extra bytes mirroring the first group, so a
+/// group can be loaded at any position without wrapping.
+typedef struct ccswiss_probe_s {
+    size_t pos;
+    size_t step;
+    size_t mask;
+} ccswiss_probe_t;
+
+static inline ccswiss_probe_t ccswiss_probe_start(size_t hash, size_t capacity) {
+    return (ccswiss_probe_t){ccswiss_h1(hash) & (capacity - 1), 0, capacity - 1};
+}
+
+static inline void ccswiss_probe_next(ccswiss_probe_t *probe) {
+    probe->step += CC_SWISS_GROUP_SIZE;
+    probe->pos = (probe->pos + probe->step) & probe->mask;
+}
+
+static inline size_t ccswiss_probe_slot(const ccswiss_probe_t *probe, int offset) {
+    return (probe->pos + offset) & probe->mask;
+}
+
+static inline void ccswiss_set_ctrl(uint8_t *ctrl, size_t capacity, size_t slot, uint8_t value) {
+    ctrl[slot] = value;
+    if(slot < CC_SWISS_GROUP_SIZE) ctrl[capacity + slot] = value;
+}
+
+/// Returns the first empty or deleted slot in the probe sequence of [hash].
+static inline size_t ccswiss_find_free(const uint8_t *ctrl, size_t capacity, size_t hash) {
+    ccswiss_probe_t probe = ccswiss_probe_start(hash, capacity);
+    for(;;) {
+        ccswiss_mask_t free = ccswiss_match_free(ctrl + probe.pos);
+        if(free) return ccswiss_probe_slot(&probe, ccswiss_first(free));
+        ccswiss_probe_next(&probe);
+    }
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
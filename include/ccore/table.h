@@ -1,5 +1,5 @@
 //===--------------------------------------------------------------------------------------------===
-// table.h - Bucket-based hash map.
+// table.h - Open-addressing hash map.
 //
 // Created by Amy Parent <amy@amyparent.com>
 // Copyright (c) 2019 Amy Parent
@@ -7,57 +7,232 @@
 // =^•.•^=
 //===--------------------------------------------------------------------------------------------===
 #pragma once
-#include <ccore/list.h>
+#include <ccore/array.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef struct ccbucket_node_s {
-    union {
-        cclist_t many_values;
-        void *one_value;
-    };
-    cclist_node_t list_node;
-    char key[];
-} ccbucket_node_t;
+/// The values mapped to a key in a multi-valued table, in the order they were inserted. The view
+/// is valid until the next insertion or removal in the table.
+typedef struct cctable_values_s {
+    void *const *data;
+    size_t count;
+} cctable_values_t;
 
-typedef struct ccbucket_value_s {
+/// An entry in a table. In multi-valued tables, [value] points to the contiguous array of values
+/// mapped to the key; use cctable_entry_values() to read it.
+/// Removed entries are left in the entry array, with a NULL key, until the table is compacted.
+/// The full [hash] and [length] of the key are kept, so that lookups rarely have to compare keys.
+typedef struct cctable_entry_s {
+    char *key;
     void *value;
-    cclist_node_t list_node;
-} ccbucket_value_t;
+    size_t hash;
+    size_t length;
+} cctable_entry_t;
+
+/// The number of size classes used to pool keys. Classes are CCTABLE_KEY_CLASS_SIZE characters
+/// apart; keys too long for the largest class use cc_alloc().
+#define CCTABLE_KEY_CLASSES (4)
+#define CCTABLE_KEY_CLASS_SIZE (32)
+
+/// The slots of an open-addressing index, probed 16 control bytes at a time. Each slot holds the
+/// position of an entry in the entry array of a table.
+typedef struct cchash_slots_s {
+    size_t capacity;
+    uint8_t *ctrl;
+    uint32_t *positions;
+} cchash_slots_t;
+
+/// The index shared by ccore's hash tables, which keep their entries in a dense array. When the
+/// index grows, entries are moved to the new slots a few at a time on each insert; until then,
+/// [old_slots] is still used to find the entries that weren't moved. Removed entries are left in
+/// the entry array as holes until the index is rebuilt.
+typedef struct cchash_index_s {
+    cchash_slots_t slots;
+    cchash_slots_t old_slots;
+    size_t rehash_pos;
+    size_t rehash_end;
+    size_t removed;
+    const cc_allocator_t *allocator;
+} cchash_index_t;
+
+struct cctable_s;
+
+/// Called when a key is added to [table] and a lookup has to probe more than the table's probe
+/// limit to find it. [probes] is the number of groups of 16 slots the lookup goes through.
+typedef void (*cctable_probe_hook_f)(
+    const struct cctable_s *table,
+    const cctable_entry_t *entry,
+    size_t probes,
+    void *user_data
+);
 
 /// A multi-valued, string-indexed hash table.
 typedef struct cctable_s {
-    size_t capacity;
     size_t size;
     bool allow_multiple;
-    cclist_t *buckets;
+    cchash_index_t index;
+    CC_VEC(cctable_entry_t) entries;
+    const cc_allocator_t *allocator;
+    cc_pool_t key_pools[CCTABLE_KEY_CLASSES];
+    cctable_probe_hook_f probe_hook;
+    void *probe_hook_data;
+    size_t probe_limit;
 } cctable_t;
 
-/// Initialises a table and allocates memory for it. [size] should be close to the maximum
-/// amount of items expected to be stored, so that items are evenly spread in the table.
+/// Initialises a table and allocates memory for it. [count] should be close to the maximum
+/// amount of keys expected to be stored, so that the table does not need to grow.
 void cctable_init(cctable_t *table, size_t count, bool allow_multiple);
 
+/// Initialises a table that allocates its index, entries and keys with [allocator].
+void cctable_init_with(
+    cctable_t *table,
+    size_t count,
+    bool allow_multiple,
+    const cc_allocator_t *allocator
+);
+
+/// Initialises a table that allocates its index, entries and keys from [arena]. The table's
+/// memory is reclaimed when [arena] is reset.
+void cctable_init_arena(cctable_t *table, size_t count, bool allow_multiple, cc_arena_t *arena);
+
+/// Makes sure [table] can hold at least [count] keys without growing. Unlike the gradual growth
+/// that happens on insertion, this rebuilds the index immediately, and is meant for bulk loads.
+void cctable_reserve(cctable_t *table, size_t count);
+
 /// De-initialises [table] and call [des] on its contents.
 void cctable_deinit(cctable_t *table, cc_destructor des, void *user_data);
 
+/// Inserts [count] keys and their [values] in [table] at once, as if by calling cctable_insert()
+/// on each pair in order: in single-valued tables the first value given for a key is kept, and
+/// in multi-valued ones all of them are, in order. Large inputs are hashed and deduplicated on
+/// the thread pool if it is running; this must not be called from a pool task.
+void cctable_build(cctable_t *table, const char *const *keys, void *const *values, size_t count);
+
+/// Same as cctable_build(), with keys whose lengths are given in [lengths].
+void cctable_build_n(
+    cctable_t *table,
+    const char *const *keys,
+    const size_t *lengths,
+    void *const *values,
+    size_t count
+);
+
 /// Maps [key] to [object] in [table].
 void cctable_insert(cctable_t *table, const char *key, void *object);
 
-/// Retrieves the entries mapped to [key] in [table].
-const cclist_t *cctable_get_many(const cctable_t *table, const char *key);
+/// Maps the [length] characters at [key] to [object] in [table].
+void cctable_insert_n(cctable_t *table, const char *key, size_t length, void *object);
+
+/// Returns a pointer to the value mapped to [key] in [table], which must not allow multiple
+/// values per key. If [key] was not in [table], it is added with a NULL value, and [inserted] is
+/// set to true if it is not NULL. The pointer is valid until the next insertion.
+void **cctable_upsert(cctable_t *table, const char *key, bool *inserted);
+
+/// Same as cctable_upsert(), with a key of [length] characters.
+void **cctable_upsert_n(cctable_t *table, const char *key, size_t length, bool *inserted);
+
+/// Removes [key] from [table], and calls [des] on the value(s) mapped to it. Returns false if
+/// [key] was not in [table].
+bool cctable_remove(cctable_t *table, const char *key, cc_destructor des, void *user_data);
+
+/// Same as cctable_remove(), with a key of [length] characters.
+bool cctable_remove_n(
+    cctable_t *table,
+    const char *key,
+    size_t length,
+    cc_destructor des,
+    void *user_data
+);
+
+/// Retrieves the values mapped to [key] in [table]. The view is empty if [key] is not in [table].
+cctable_values_t cctable_get_many(const cctable_t *table, const char *key);
+
+/// Retrieves the values mapped to the [length] characters at [key] in [table].
+cctable_values_t cctable_get_many_n(const cctable_t *table, const char *key, size_t length);
+
+/// Returns the values of [entry], which belongs to the multi-valued [table].
+cctable_values_t cctable_entry_values(const cctable_t *table, const cctable_entry_t *entry);
 
 /// Retrieves the entry mapped to [key] in [table].
 void *cctable_get_one(const cctable_t *table, const char *key);
 
+/// Retrieves the entry mapped to the [length] characters at [key] in [table].
+void *cctable_get_one_n(const cctable_t *table, const char *key, size_t length);
+
 /// A function that can be used to iterate over a hash table.
 typedef void (*cctable_callback_f)(const char *, const void *, void *);
 
 /// Calls [callback] for each element stored in [table], with arbitrary data [ptr].
 void cctable_iter(const cctable_t *table, cctable_callback_f callback, void *ptr);
 
+/// A cursor over the entries of a table, in insertion order.
+typedef struct cctable_cursor_s {
+    const cctable_t *table;
+    size_t position;
+} cctable_cursor_t;
+
+/// Returns a cursor to the first entry in [table].
+cctable_cursor_t cctable_cursor(const cctable_t *table);
+
+/// Returns the entry at [cursor] and moves it forward, or returns NULL at the end of the table.
+/// The entry just returned can be removed while iterating, but inserting invalidates the cursor.
+const cctable_entry_t *cctable_next(cctable_cursor_t *cursor);
+
+/// The number of buckets in the probe length histogram of cctable_stats_t.
+#define CCTABLE_PROBE_HISTOGRAM (8)
+
+/// A snapshot of the shape and memory use of a table. [holes] are removed entries not yet
+/// compacted away, and [tombstones] the index slots they leave behind. [load] is the fraction of
+/// slots holding a key or a tombstone. Probe lengths count the groups of 16 slots a lookup goes
+/// through before finding a key, so 1 means the key was in its home group; [probe_histogram][i]
+/// counts the keys found after i+1 groups, and its last bucket the keys that took more.
+/// [index_bytes] includes the old slots if [rehashing], and [entry_bytes] the unused capacity of
+/// the entry array.
+typedef struct cctable_stats_s {
+    size_t size;
+    size_t keys;
+    size_t holes;
+    size_t capacity;
+    size_t tombstones;
+    double load;
+    bool rehashing;
+
+    size_t max_probe;
+    double mean_probe;
+    size_t probe_histogram[CCTABLE_PROBE_HISTOGRAM];
+
+    size_t index_bytes;
+    size_t entry_bytes;
+    size_t key_bytes;
+    size_t value_bytes;
+} cctable_stats_t;
+
+/// Fills [stats] with the shape and memory use of [table]. This walks every entry and slot, so
+/// it is meant for tuning and debugging rather than to be called on hot paths.
+void cctable_stats(const cctable_t *table, cctable_stats_t *stats);
+
+/// Calls [hook] whenever a key is added to [table] and a lookup would need more than [limit]
+/// groups of probes to find it, which usually points to a poor hash or adversarial keys. Pass a
+/// NULL [hook] to disable it. Adding keys is slightly slower while a hook is set.
+void cctable_set_probe_hook(
+    cctable_t *table,
+    size_t limit,
+    cctable_probe_hook_f hook,
+    void *user_data
+);
+
+/// A probe hook that logs the pathological key as a warning.
+void cctable_log_probe(
+    const cctable_t *table,
+    const cctable_entry_t *entry,
+    size_t probes,
+    void *user_data
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -20,6 +20,9 @@ void ccpool_stop();
 void ccpool_submit(ccpool_task_t task, void *refcon);
 void ccpool_wait();
 
+/// Returns the number of worker threads in the pool, or 0 if it is not running.
+int ccpool_thread_count();
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
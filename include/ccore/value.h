@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <ccore/log.h>
+#include <ccore/memory.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -85,6 +86,7 @@ struct object_s {
     enum {OBJ_LEG, OBJ_STR} kind;
     object_t *next;
     bool is_marked;
+    uint32_t size;
 };
 
 typedef struct obj_gc_s {
@@ -92,12 +94,14 @@ typedef struct obj_gc_s {
     object_t *head;
     size_t allocated;
     size_t next_collect;
+    const cc_allocator_t *allocator;
 } obj_gc_t;
 
 int val_compare_wpt(const void *ap, const void *bp);
 int val_compare_string(const void *ap, const void *bp);
 
 void gc_init(obj_gc_t *gc);
+void gc_init_with(obj_gc_t *gc, const cc_allocator_t *allocator);
 void gc_deinit(obj_gc_t *gc);
 void gc_collect(obj_gc_t *gc);
 void *gc_new(obj_gc_t *gc, size_t size, int kind);
@@ -0,0 +1,201 @@
+//===--------------------------------------------------------------------------------------------===
+// array.c - Contiguous dynamically allocated array
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/array.h>
+#include <ccore/log.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define VEC_MIN_CAPACITY (4)
+
+static inline unsigned char *elem_at(const ccvec_base_t *vec, size_t elem_size, size_t index) {
+    return (unsigned char *)vec->data + index * elem_size;
+}
+
+static inline bool vec_is_inline(const ccvec_base_t *vec) {
+    return vec->inline_data && vec->data == vec->inline_data;
+}
+
+// Small vectors move between their inline buffer and the heap by copying, since the inline buffer
+// can't be handed to the allocator.
+static void vec_set_capacity(ccvec_base_t *vec, size_t elem_size, size_t capacity) {
+    CCASSERT(capacity >= vec->count);
+    if(vec_is_inline(vec)) {
+        void *data = cc_alloc_with(vec->allocator, capacity * elem_size);
+        memcpy(data, vec->data, vec->count * elem_size);
+        vec->data = data;
+        vec->capacity = capacity;
+        return;
+    }
+
+    if(capacity <= vec->inline_capacity) {
+        memcpy(vec->inline_data, vec->data, vec->count * elem_size);
+        cc_free_with(vec->allocator, vec->data, vec->capacity * elem_size);
+        vec->data = vec->inline_data;
+        vec->capacity = vec->inline_capacity;
+        return;
+    }
+
+    vec->data = cc_realloc_with(
+        vec->allocator,
+        vec->data,
+        vec->capacity * elem_size,
+        capacity * elem_size
+    );
+    vec->capacity = capacity;
+}
+
+void ccvec_init(ccvec_base_t *vec, const cc_allocator_t *allocator) {
+    CCASSERT(vec);
+    vec->data = NULL;
+    vec->count = 0;
+    vec->capacity = 0;
+    vec->allocator = allocator;
+    vec->inline_data = NULL;
+    vec->inline_capacity = 0;
+}
+
+void ccvec_init_inline(
+    ccvec_base_t *vec,
+    const cc_allocator_t *allocator,
+    void *storage,
+    size_t capacity
+) {
+    CCASSERT(vec);
+    CCASSERT(storage);
+    vec->data = storage;
+    vec->count = 0;
+    vec->capacity = capacity;
+    vec->allocator = allocator;
+    vec->inline_data = storage;
+    vec->inline_capacity = capacity;
+}
+
+void ccvec_deinit(ccvec_base_t *vec, size_t elem_size) {
+    CCASSERT(vec);
+    if(vec->data && !vec_is_inline(vec)) {
+        cc_free_with(vec->allocator, vec->data, vec->capacity * elem_size);
+    }
+    if(vec->inline_data) {
+        ccvec_init_inline(vec, vec->allocator, vec->inline_data, vec->inline_capacity);
+    } else {
+        ccvec_init(vec, vec->allocator);
+    }
+}
+
+void ccvec_reserve(ccvec_base_t *vec, size_t elem_size, size_t capacity) {
+    CCASSERT(vec);
+    if(capacity <= vec->capacity) return;
+    vec_set_capacity(vec, elem_size, capacity);
+}
+
+void ccvec_reserve_more(ccvec_base_t *vec, size_t elem_size, size_t count) {
+    CCASSERT(vec);
+    size_t needed = vec->count + count;
+    if(needed <= vec->capacity) return;
+
+    size_t capacity = vec->capacity ? vec->capacity * 2 : VEC_MIN_CAPACITY;
+    if(capacity < needed) capacity = needed;
+    vec_set_capacity(vec, elem_size, capacity);
+}
+
+void ccvec_shrink_to_fit(ccvec_base_t *vec, size_t elem_size) {
+    CCASSERT(vec);
+    if(vec->count == vec->capacity) return;
+    if(!vec->count) {
+        ccvec_deinit(vec, elem_size);
+        return;
+    }
+    if(vec_is_inline(vec)) return;
+    vec_set_capacity(vec, elem_size, vec->count);
+}
+
+void *ccvec_insert_gap(ccvec_base_t *vec, size_t elem_size, size_t index, size_t count) {
+    CCASSERT(vec);
+    CCASSERT(index <= vec->count);
+    ccvec_reserve_more(vec, elem_size, count);
+    memmove(
+        elem_at(vec, elem_size, index + count),
+        elem_at(vec, elem_size, index),
+        (vec->count - index) * elem_size
+    );
+    vec->count += count;
+    return elem_at(vec, elem_size, index);
+}
+
+void ccvec_remove(ccvec_base_t *vec, size_t elem_size, size_t index, size_t count) {
+    CCASSERT(vec);
+    CCASSERT(index + count <= vec->count);
+    memmove(
+        elem_at(vec, elem_size, index),
+        elem_at(vec, elem_size, index + count),
+        (vec->count - index - count) * elem_size
+    );
+    vec->count -= count;
+}
+
+void ccvec_append(ccvec_base_t *vec, size_t elem_size, const void *elements, size_t count) {
+    CCASSERT(vec);
+    if(!count) return;
+    CCASSERT(elements);
+
+    // Growing frees the old storage, so elements that come from [vec] itself are found again by
+    // their offset once it has moved.
+    uintptr_t source = (uintptr_t)elements;
+    uintptr_t data = (uintptr_t)vec->data;
+    bool aliases = data && source >= data && source - data < vec->capacity * elem_size;
+
+    ccvec_reserve_more(vec, elem_size, count);
+    if(aliases) elements = (const unsigned char *)vec->data + (source - data);
+    memcpy(elem_at(vec, elem_size, vec->count), elements, count * elem_size);
+    vec->count += count;
+}
+
+// MARK: - Pointer arrays
+
+void ccarray_init(ccarray_t *array) {
+    CC_VEC_INIT(array);
+}
+
+void ccarray_init_with(ccarray_t *array, const cc_allocator_t *allocator) {
+    CC_VEC_INIT_WITH(array, allocator);
+}
+
+void ccarray_deinit(ccarray_t *array) {
+    CC_VEC_DEINIT(array);
+}
+
+void ccarray_clear(ccarray_t *array, cc_destructor des, void *ptr) {
+    CCASSERT(array);
+    if(des) {
+        for(size_t i = 0; i < array->count; ++i) {
+            des(array->data[i], ptr);
+        }
+    }
+    CC_VEC_CLEAR(array);
+}
+
+void ccarray_add_first(ccarray_t *array, void *item) {
+    CC_VEC_INSERT(array, 0, item);
+}
+
+void ccarray_add_last(ccarray_t *array, void *item) {
+    CC_VEC_PUSH(array, item);
+}
+
+void ccarray_insert_at(ccarray_t *array, void *item, size_t n) {
+    CC_VEC_INSERT(array, n, item);
+}
+
+void *ccarray_remove_at(ccarray_t *array, size_t n) {
+    CCASSERT(array);
+    CCASSERT(n < array->count);
+    void *item = array->data[n];
+    CC_VEC_REMOVE(array, n);
+    return item;
+}
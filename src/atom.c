@@ -0,0 +1,149 @@
+//===--------------------------------------------------------------------------------------------===
+// atom.c - Interned strings
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/atom.h>
+#include <ccore/hash.h>
+#include <ccore/log.h>
+#include <ccore/memory.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+// Atoms are found through a linear-probing array of pointers. Atoms are never removed, so a
+// lookup can probe without locking: a slot only ever goes from NULL to an atom, which is fully
+// written before it is published.
+//
+// When the array grows, the new one is published once it holds every atom, and the old one is
+// left in the arena, since lookups may still be reading it. Each array is twice the size of the
+// last, so the old ones take less space than the current one.
+
+#define MIN_CAPACITY (256)
+
+typedef struct atom_slots_s {
+    size_t capacity;
+    _Atomic(cc_atom_t) atoms[];
+} atom_slots_t;
+
+static pthread_once_t atoms_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t atoms_lock = PTHREAD_MUTEX_INITIALIZER;
+static cc_arena_t atoms_arena;
+static _Atomic(atom_slots_t *) atoms_slots;
+static atomic_size_t atoms_count;
+
+static atom_slots_t *slots_new(size_t capacity) {
+    size_t size = sizeof(atom_slots_t) + capacity * sizeof(cc_atom_t);
+    atom_slots_t *slots = cc_arena_alloc(&atoms_arena, size);
+    slots->capacity = capacity;
+    for(size_t i = 0; i < capacity; ++i) atomic_init(&slots->atoms[i], NULL);
+    return slots;
+}
+
+static void atoms_init(void) {
+    cc_arena_init(&atoms_arena, 0);
+    atomic_store_explicit(&atoms_slots, slots_new(MIN_CAPACITY), memory_order_release);
+}
+
+// Returns the slot of the atom for [str], or of the empty slot where it belongs.
+static size_t slots_find(
+    const atom_slots_t *slots,
+    uint64_t hash,
+    const char *str,
+    size_t length,
+    cc_atom_t *found
+) {
+    size_t mask = slots->capacity - 1;
+    for(size_t i = hash & mask;; i = (i + 1) & mask) {
+        cc_atom_t atom = atomic_load_explicit(&slots->atoms[i], memory_order_acquire);
+        *found = atom;
+        if(!atom) return i;
+        if(atom->hash == hash && atom->length == length && !memcmp(atom->str, str, length)) {
+            return i;
+        }
+    }
+}
+
+static cc_atom_t atom_find(uint64_t hash, const char *str, size_t length) {
+    pthread_once(&atoms_once, atoms_init);
+    atom_slots_t *slots = atomic_load_explicit(&atoms_slots, memory_order_acquire);
+    cc_atom_t atom;
+    slots_find(slots, hash, str, length, &atom);
+    return atom;
+}
+
+// Called with atoms_lock held. Slots are kept at most half full, to keep probes short.
+static atom_slots_t *slots_grow(atom_slots_t *old) {
+    atom_slots_t *slots = slots_new(old->capacity * 2);
+    for(size_t i = 0; i < old->capacity; ++i) {
+        cc_atom_t atom = atomic_load_explicit(&old->atoms[i], memory_order_relaxed);
+        if(!atom) continue;
+        cc_atom_t unused;
+        size_t slot = slots_find(slots, atom->hash, atom->str, atom->length, &unused);
+        atomic_store_explicit(&slots->atoms[slot], atom, memory_order_relaxed);
+    }
+    atomic_store_explicit(&atoms_slots, slots, memory_order_release);
+    return slots;
+}
+
+static cc_atom_t atom_intern(uint64_t hash, const char *str, size_t length) {
+    pthread_mutex_lock(&atoms_lock);
+
+    // Another thread may have interned the same string since the lookup.
+    atom_slots_t *slots = atomic_load_explicit(&atoms_slots, memory_order_relaxed);
+    size_t count = atomic_load_explicit(&atoms_count, memory_order_relaxed);
+    cc_atom_t atom;
+    size_t slot = slots_find(slots, hash, str, length, &atom);
+    if(atom) {
+        pthread_mutex_unlock(&atoms_lock);
+        return atom;
+    }
+    if(count + 1 > slots->capacity / 2) {
+        slots = slots_grow(slots);
+        slot = slots_find(slots, hash, str, length, &atom);
+    }
+
+    CCASSERT(count < UINT32_MAX);
+    size_t size = sizeof(struct cc_atom_s) + length + 1;
+    struct cc_atom_s *created = cc_arena_alloc(&atoms_arena, size);
+    created->hash = hash;
+    created->id = count;
+    created->length = length;
+    memcpy(created->str, str, length);
+    created->str[length] = '\0';
+
+    atomic_store_explicit(&slots->atoms[slot], created, memory_order_release);
+    atomic_store_explicit(&atoms_count, count + 1, memory_order_relaxed);
+    pthread_mutex_unlock(&atoms_lock);
+    return created;
+}
+
+cc_atom_t cc_atom(const char *str) {
+    CCASSERT(str);
+    return cc_atom_n(str, strlen(str));
+}
+
+cc_atom_t cc_atom_n(const char *str, size_t length) {
+    CCASSERT(str);
+    CCASSERT(length <= UINT32_MAX);
+    uint64_t hash = cc_hash_bytes(str, length, 0);
+    cc_atom_t atom = atom_find(hash, str, length);
+    return atom ? atom : atom_intern(hash, str, length);
+}
+
+cc_atom_t cc_atom_find(const char *str) {
+    CCASSERT(str);
+    return cc_atom_find_n(str, strlen(str));
+}
+
+cc_atom_t cc_atom_find_n(const char *str, size_t length) {
+    CCASSERT(str);
+    return atom_find(cc_hash_bytes(str, length, 0), str, length);
+}
+
+size_t cc_atom_count(void) {
+    return atomic_load_explicit(&atoms_count, memory_order_relaxed);
+}
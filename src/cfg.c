@@ -7,6 +7,7 @@
 // =^•.•^=
 //===--------------------------------------------------------------------------------------------===
 #include <ccore/cfg.h>
+#include <ccore/atom.h>
 #include <ccore/table.h>
 #include <ccore/memory.h>
 #include <ccore/filesystem.h>
@@ -19,8 +20,9 @@
 
 #define CC_CFG_DEFAULT_CAPACITY (32)
 
+// Keys are interned, so that finding an entry compares pointers rather than strings.
 typedef struct {
-    char *key;
+    cc_atom_t key;
     enum {CFG_NIL, CFG_STR, CFG_NUM, CFG_BOOL} kind;
     char *str;
     double f64;
@@ -32,12 +34,18 @@ typedef struct cc_cfg_s {
     size_t count;
     size_t capacity;
     cc_cfg_entry_t *entries;
+    const cc_allocator_t *allocator;
 } cc_cfg_t;
 
+static inline void free_string(const cc_cfg_t *cfg, char *str) {
+    cc_free_with(cfg->allocator, str, strlen(str) + 1);
+}
+
 
 static cc_cfg_entry_t *find_entry(const cc_cfg_t *cfg, const char *key) {
-    for(size_t i = 0; i < cfg->count; ++i) {
-        if(strcmp(key, cfg->entries[i].key)) continue;
+    cc_atom_t atom = cc_atom_find(key);
+    for(size_t i = 0; atom && i < cfg->count; ++i) {
+        if(cfg->entries[i].key != atom) continue;
         return &cfg->entries[i];
     }
     CCWARN("No entry for key `%s`", key);
@@ -46,21 +54,28 @@ static cc_cfg_entry_t *find_entry(const cc_cfg_t *cfg, const char *key) {
 
 static void ensure(cc_cfg_t *cfg) {
     if(cfg->count + 1 < cfg->capacity) return;
+    size_t old_capacity = cfg->capacity;
     cfg->capacity = cfg->capacity ? cfg->capacity * 2 : CC_CFG_DEFAULT_CAPACITY;
-    cfg->entries = cc_realloc(cfg->entries, cfg->capacity * sizeof(cc_cfg_entry_t));
+    cfg->entries = cc_realloc_with(
+        cfg->allocator,
+        cfg->entries,
+        old_capacity * sizeof(cc_cfg_entry_t),
+        cfg->capacity * sizeof(cc_cfg_entry_t)
+    );
 }
 
 static cc_cfg_entry_t *find_entry_or_add(cc_cfg_t *cfg, const char *key) {
+    cc_atom_t atom = cc_atom(key);
     cc_cfg_entry_t *entry = NULL;
     for(size_t i = 0; i < cfg->count; ++i) {
-        if(strcmp(key, cfg->entries[i].key)) continue;
+        if(cfg->entries[i].key != atom) continue;
         entry = &cfg->entries[i];
         break;
     }
     if(entry) return entry;
     ensure(cfg);
     entry = &cfg->entries[cfg->count++];
-    entry->key = string_duplicate(key);
+    entry->key = atom;
     return entry;
 }
 
@@ -106,7 +121,7 @@ static bool parse_number(char **value, cc_cfg_entry_t *entry) {
 
     if(*src == '-' || *src == '+') src += 1;
     if(!isdigit(*src) && *src != '.') {
-        CCERROR("invalid configuration: missing number for key `%s`", entry->key);
+        CCERROR("invalid configuration: missing number for key `%s`", cc_atom_str(entry->key));
         success = false;
         goto done;
     }
@@ -128,14 +143,17 @@ done:
     return success;
 }
 
-static bool parse_string(char **value, cc_cfg_entry_t *entry, char delim) {
+static bool parse_string(cc_cfg_t *cfg, char **value, cc_cfg_entry_t *entry, char delim) {
     char *src = *value + 1;
     const char *start = src;
     bool success = true;
 
     while(*src != delim) {
         if(!*src) {
-            CCERROR("invalid configuration: missing closing quote for key `%s`", entry->key);
+            CCERROR(
+                "invalid configuration: missing closing quote for key `%s`",
+                cc_atom_str(entry->key)
+            );
             success = false;
             goto done;
         }
@@ -149,7 +167,7 @@ static bool parse_string(char **value, cc_cfg_entry_t *entry, char delim) {
     entry->f64 = 0;
     entry->i64 = 0;
     entry->b = true;
-    entry->str = string_duplicate(start);
+    entry->str = string_duplicate_with(start, cfg->allocator);
 done:
     *value = src;
     return success;
@@ -184,15 +202,15 @@ static bool parse_bool(char **value, cc_cfg_entry_t *entry) {
 static void debug_entry(const cc_cfg_entry_t *entry) {
     CCASSERT(entry);
     switch(entry->kind) {
-    case CFG_NIL: CCDEBUG("(%s: <nil>)", entry->key); break;
-    case CFG_STR: CCDEBUG("(%s: `%s`)", entry->key, entry->str); break;
-    case CFG_BOOL: CCDEBUG("(%s: %s)", entry->key, entry->b ? "true" : "false"); break;
-    case CFG_NUM: CCDEBUG("(%s: %f)", entry->key, entry->f64); break;
+    case CFG_NIL: CCDEBUG("(%s: <nil>)", cc_atom_str(entry->key)); break;
+    case CFG_STR: CCDEBUG("(%s: `%s`)", cc_atom_str(entry->key), entry->str); break;
+    case CFG_BOOL: CCDEBUG("(%s: %s)", cc_atom_str(entry->key), entry->b ? "true" : "false"); break;
+    case CFG_NUM: CCDEBUG("(%s: %f)", cc_atom_str(entry->key), entry->f64); break;
     }
 }
 #endif
 
-static bool parse_value(char **value, cc_cfg_entry_t *entry) {
+static bool parse_value(cc_cfg_t *cfg, char **value, cc_cfg_entry_t *entry) {
     switch(**value) {
 
     case '.': case '+': case '-':
@@ -206,17 +224,17 @@ static bool parse_value(char **value, cc_cfg_entry_t *entry) {
 
     case '\'':
     case '\"':
-        return parse_string(value, entry, **value);
+        return parse_string(cfg, value, entry, **value);
 
     case '\0':
-        CCERROR("invalid configuration: missing value for key `%s`", entry->key);
+        CCERROR("invalid configuration: missing value for key `%s`", cc_atom_str(entry->key));
         return false;
 
     default:
         CCERROR(
             "invalid configuration: `%s` is not a valid value for key `%s`",
             *value,
-            entry->key
+            cc_atom_str(entry->key)
         );
         return false;
     }
@@ -250,7 +268,7 @@ static bool parse(cc_cfg_t *cfg, FILE *f) {
         // CCDEBUG("key: %s, value: %s", key, value);
         cc_cfg_entry_t *entry = find_entry_or_add(cfg, key);
         CCASSERT(entry);
-        if(!parse_value(&value, entry)) {
+        if(!parse_value(cfg, &value, entry)) {
             success = false;
             goto done;
         }
@@ -273,14 +291,24 @@ done:
 }
 
 cc_cfg_t *cc_cfg_load(const char *path) {
+    return cc_cfg_load_with(path, NULL);
+}
+
+cc_cfg_t *cc_cfg_load_arena(const char *path, cc_arena_t *arena) {
+    CCASSERT(arena);
+    return cc_cfg_load_with(path, cc_arena_allocator(arena));
+}
+
+cc_cfg_t *cc_cfg_load_with(const char *path, const cc_allocator_t *allocator) {
     CCASSERT(path);
     FILE *file = ccfs_file_open(path, CCFS_READ);
     if(!file) return NULL;
 
-    cc_cfg_t *cfg = cc_alloc(sizeof(cc_cfg_t));
+    cc_cfg_t *cfg = cc_alloc_with(allocator, sizeof(cc_cfg_t));
     cfg->entries = NULL;
     cfg->capacity = 0;
     cfg->count = 0;
+    cfg->allocator = allocator;
 
     parse(cfg, file);
     fclose(file);
@@ -290,11 +318,10 @@ void cc_cfg_delete(cc_cfg_t *cfg) {
     CCASSERT(cfg);
     for(size_t i = 0; i < cfg->count; ++i) {
         cc_cfg_entry_t *entry = &cfg->entries[i];
-        if(entry->kind == CFG_STR) cc_free(entry->str);
-        cc_free(entry->key);
+        if(entry->kind == CFG_STR) free_string(cfg, entry->str);
     }
-    cc_free(cfg->entries);
-    cc_free(cfg);
+    cc_free_with(cfg->allocator, cfg->entries, cfg->capacity * sizeof(cc_cfg_entry_t));
+    cc_free_with(cfg->allocator, cfg, sizeof(cc_cfg_t));
 }
 
 bool cc_cfg_key_exists(const cc_cfg_t *cfg, const char *fmt, ...) {
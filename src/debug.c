@@ -257,6 +257,12 @@ void cc_print_stack(int skip_frames) {
     pthread_mutex_unlock(&backtrace_lock);
 }
 
+int
+cc_capture_stack(void **frames, int max, int skip_frames)
+{
+	return RtlCaptureStackBackTrace(skip_frames + 1, max, frames, NULL);
+}
+
 void
 cc_print_stack_sw64(PCONTEXT ctx)
 {
@@ -371,4 +377,16 @@ cc_print_stack(int skip_frames)
 	free(fnames);
 }
 
+int
+cc_capture_stack(void **frames, int max, int skip_frames)
+{
+	void *trace[MAX_STACK_FRAMES];
+	int sz, count;
+
+	sz = backtrace(trace, MAX_STACK_FRAMES);
+	for (count = 0; count < max && count + 1 + skip_frames < sz; count++)
+		frames[count] = trace[count + 1 + skip_frames];
+	return (count);
+}
+
 #endif
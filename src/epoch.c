@@ -0,0 +1,100 @@
+//===--------------------------------------------------------------------------------------------===
+// epoch.c - Epoch-based memory reclamation
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include "epoch.h"
+#include <ccore/memory.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+// Each thread that reads gets a record, padded to a cache line so that entering an epoch never
+// touches memory shared with other readers. Records are never freed: a thread's record is put
+// back in the list when it exits, and reused by the next thread that needs one.
+typedef struct epoch_record_s {
+    _Alignas(CC_CACHE_LINE_SIZE) _Atomic uint64_t active;
+    atomic_bool in_use;
+    struct epoch_record_s *next;
+} epoch_record_t;
+
+static _Atomic uint64_t global_epoch = 1;
+static _Atomic(epoch_record_t *) records;
+
+static _Thread_local epoch_record_t *local_record;
+static _Thread_local unsigned local_depth;
+static pthread_once_t epoch_once = PTHREAD_ONCE_INIT;
+static pthread_key_t thread_key;
+
+static void thread_exit(void *data) {
+    epoch_record_t *record = data;
+    atomic_store_explicit(&record->active, 0, memory_order_release);
+    atomic_store_explicit(&record->in_use, false, memory_order_release);
+}
+
+static void epoch_init(void) {
+    pthread_key_create(&thread_key, thread_exit);
+}
+
+static epoch_record_t *acquire_record(void) {
+    pthread_once(&epoch_once, epoch_init);
+
+    epoch_record_t *record = atomic_load_explicit(&records, memory_order_acquire);
+    for(; record; record = record->next) {
+        bool expected = false;
+        if(atomic_compare_exchange_strong(&record->in_use, &expected, true)) break;
+    }
+
+    if(!record) {
+        record = cc_alloc_aligned(sizeof(epoch_record_t), CC_CACHE_LINE_SIZE);
+        atomic_init(&record->active, 0);
+        atomic_init(&record->in_use, true);
+        record->next = atomic_load_explicit(&records, memory_order_relaxed);
+        while(!atomic_compare_exchange_weak_explicit(
+            &records, &record->next, record, memory_order_release, memory_order_relaxed));
+    }
+    pthread_setspecific(thread_key, record);
+    return record;
+}
+
+void epoch_enter(void) {
+    if(local_depth++) return;
+    if(!local_record) local_record = acquire_record();
+    // The store must be visible to writers before any shared pointer is read. A seq_cst store
+    // alone does not keep later acquire loads from moving before it, so a full fence follows it,
+    // which pairs with the one in try_advance().
+    atomic_store(&local_record->active, atomic_load(&global_epoch));
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+void epoch_exit(void) {
+    if(--local_depth) return;
+    atomic_store_explicit(&local_record->active, 0, memory_order_release);
+}
+
+uint64_t epoch_current(void) {
+    return atomic_load(&global_epoch);
+}
+
+// The epoch can move from E to E + 1 once every active reader is in E. Memory tagged with E was
+// unlinked before any reader entered E + 1, so once the epoch reaches E + 2, the readers that
+// could still see it have all exited.
+static uint64_t try_advance(void) {
+    uint64_t epoch = atomic_load(&global_epoch);
+    // Pairs with the fence in epoch_enter(): either this scan sees the reader's epoch, or the
+    // reader sees every pointer unlinked before it.
+    atomic_thread_fence(memory_order_seq_cst);
+    epoch_record_t *record = atomic_load_explicit(&records, memory_order_acquire);
+    for(; record; record = record->next) {
+        uint64_t active = atomic_load(&record->active);
+        if(active && active != epoch) return epoch;
+    }
+    if(atomic_compare_exchange_strong(&global_epoch, &epoch, epoch + 1)) return epoch + 1;
+    return epoch;
+}
+
+uint64_t epoch_advance(void) {
+    return try_advance();
+}
@@ -0,0 +1,31 @@
+//===--------------------------------------------------------------------------------------------===
+// epoch - private header for epoch-based memory reclamation
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Lock-free readers announce the global epoch they started in with epoch_enter(), and clear it
+// with epoch_exit(). Writers unlink memory first, then tag it with epoch_current() rather than
+// freeing it. The epoch only moves forward once every active reader has seen the current one, so
+// memory tagged with epoch E can no longer be reached by any reader once the epoch reaches E + 2.
+//
+// Readers never block, and writers never wait for readers: a reader that stalls only delays
+// reclamation.
+
+// Marks the calling thread as reading shared memory. Calls can be nested.
+void epoch_enter(void);
+void epoch_exit(void);
+
+// Returns the global epoch. Call it after unlinking memory, to tag it.
+uint64_t epoch_current(void);
+
+// Tries to move the global epoch forward, and returns it. Memory tagged with an epoch at least two
+// behind the result can be freed, so a whole list can be checked with a single scan of readers.
+uint64_t epoch_advance(void);
@@ -0,0 +1,218 @@
+//===--------------------------------------------------------------------------------------------===
+// frozen.c - Immutable tables indexed by a minimal perfect hash
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/frozen.h>
+#include <ccore/hash.h>
+#include <ccore/log.h>
+#include <ccore/memory.h>
+#include "phash.h"
+#include <string.h>
+
+// The perfect hash is built with "hash and displace": keys are split into buckets of about
+// PHASH_KEYS_PER_BUCKET keys, and buckets are placed largest first. For each bucket, pilots 0,
+// 1, ... are tried until every key of the bucket lands on a free slot. Large buckets are placed
+// while most slots are free, and the single-key buckets placed last only need to find any free
+// slot.
+//
+// If a bucket cannot be placed in MAX_PILOT tries, the whole build starts over with another seed.
+
+#define MAX_PILOT (1u << 24)
+#define MAX_SEEDS (8)
+
+typedef struct {
+    uint64_t hash;
+    const cctable_entry_t *entry;
+} build_key_t;
+
+// Lookups hash keys with the full 64 bits of cc_hash_bytes(), but table entries keep a size_t.
+// Where that is narrower, the key is hashed again so that both sides agree.
+static inline uint64_t entry_hash(const cctable_entry_t *entry) {
+    if(sizeof(size_t) >= sizeof(uint64_t)) return entry->hash;
+    return cc_hash_bytes(entry->key, entry->length, 0);
+}
+
+// Keys with the same hash land on the same slot whatever the pilot, so no perfect hash exists.
+static bool has_duplicate_hash(const build_key_t *keys, size_t start, size_t end) {
+    for(size_t i = start; i < end; ++i) {
+        for(size_t j = i + 1; j < end; ++j) {
+            if(keys[i].hash == keys[j].hash) return true;
+        }
+    }
+    return false;
+}
+
+// Places every bucket, and stores the slot of each key in [slots]. [keys] is sorted by bucket,
+// with the keys of bucket i starting at [offsets][i]; buckets are placed in the order of [order].
+static bool place_buckets(
+    const ccfrozen_table_t *frozen,
+    const build_key_t *keys,
+    const size_t *offsets,
+    const size_t *order,
+    uint8_t *taken,
+    size_t *slots
+) {
+    size_t size = frozen->size;
+    memset(taken, 0, size);
+
+    for(size_t i = 0; i < frozen->bucket_count; ++i) {
+        size_t bucket = order[i];
+        size_t start = offsets[bucket], end = offsets[bucket + 1];
+        if(start == end) break;
+        if(has_duplicate_hash(keys, start, end)) return false;
+
+        uint32_t pilot = 0;
+        for(; pilot < MAX_PILOT; ++pilot) {
+            size_t k = start;
+            for(; k < end; ++k) {
+                size_t slot = phash_slot(keys[k].hash, frozen->seed, pilot, size);
+                if(taken[slot]) break;
+                taken[slot] = 1;
+                slots[k] = slot;
+            }
+            if(k == end) break;
+            for(size_t j = start; j < k; ++j) taken[slots[j]] = 0;
+        }
+        if(pilot == MAX_PILOT) return false;
+        frozen->pilots[bucket] = pilot;
+    }
+    return true;
+}
+
+bool cctable_freeze(const cctable_t *table, ccfrozen_table_t *frozen) {
+    return cctable_freeze_with(table, frozen, NULL);
+}
+
+bool cctable_freeze_with(
+    const cctable_t *table,
+    ccfrozen_table_t *frozen,
+    const cc_allocator_t *allocator
+) {
+    CCASSERT(table);
+    CCASSERT(frozen);
+    CCASSERT(!table->allow_multiple);
+
+    size_t size = table->size;
+    size_t bucket_count = size / PHASH_KEYS_PER_BUCKET + 1;
+    size_t key_bytes = 0;
+
+    cctable_cursor_t cursor = cctable_cursor(table);
+    for(const cctable_entry_t *entry; (entry = cctable_next(&cursor));) {
+        key_bytes += entry->length + 1;
+    }
+    CCASSERT(key_bytes <= UINT32_MAX);
+
+    frozen->size = size;
+    frozen->bucket_count = bucket_count;
+    frozen->allocator = allocator;
+    frozen->memory_size = size * sizeof(ccfrozen_entry_t)
+        + bucket_count * sizeof(uint32_t)
+        + key_bytes;
+    frozen->entries = cc_alloc_with(allocator, frozen->memory_size);
+    frozen->pilots = (uint32_t *)(frozen->entries + size);
+    frozen->keys = (char *)(frozen->pilots + bucket_count);
+
+    // Sort keys by bucket, then buckets by decreasing size, both with a counting sort.
+    build_key_t *keys = cc_alloc(size * sizeof(build_key_t) + 1);
+    size_t *offsets = cc_alloc((bucket_count + 1) * sizeof(size_t));
+    size_t *order = cc_alloc(bucket_count * sizeof(size_t));
+    size_t *slots = cc_alloc(size * sizeof(size_t) + 1);
+    uint8_t *taken = cc_alloc(size + 1);
+
+    memset(offsets, 0, (bucket_count + 1) * sizeof(size_t));
+    cursor = cctable_cursor(table);
+    for(const cctable_entry_t *entry; (entry = cctable_next(&cursor));) {
+        offsets[phash_bucket(entry_hash(entry), bucket_count) + 1] += 1;
+    }
+    size_t max_bucket = 0;
+    for(size_t i = 0; i < bucket_count; ++i) {
+        if(offsets[i + 1] > max_bucket) max_bucket = offsets[i + 1];
+        offsets[i + 1] += offsets[i];
+    }
+
+    size_t *fill = cc_alloc((max_bucket + 2) * sizeof(size_t));
+    memset(fill, 0, (max_bucket + 2) * sizeof(size_t));
+    for(size_t i = 0; i < bucket_count; ++i) {
+        fill[max_bucket - (offsets[i + 1] - offsets[i]) + 1] += 1;
+    }
+    for(size_t i = 0; i <= max_bucket; ++i) fill[i + 1] += fill[i];
+    for(size_t i = 0; i < bucket_count; ++i) {
+        order[fill[max_bucket - (offsets[i + 1] - offsets[i])]++] = i;
+    }
+
+    size_t *next = cc_alloc(bucket_count * sizeof(size_t));
+    memcpy(next, offsets, bucket_count * sizeof(size_t));
+    cursor = cctable_cursor(table);
+    for(const cctable_entry_t *entry; (entry = cctable_next(&cursor));) {
+        uint64_t hash = entry_hash(entry);
+        keys[next[phash_bucket(hash, bucket_count)]++] = (build_key_t){hash, entry};
+    }
+    cc_free(next);
+
+    // A duplicate hash makes place_buckets() fail straight away, whatever the seed.
+    bool placed = false;
+    for(uint64_t i = 0; i < MAX_SEEDS && !placed; ++i) {
+        frozen->seed = cc_hash_u64(i);
+        memset(frozen->pilots, 0, bucket_count * sizeof(uint32_t));
+        placed = place_buckets(frozen, keys, offsets, order, taken, slots);
+    }
+
+    if(placed) {
+        size_t key_offset = 0;
+        for(size_t i = 0; i < size; ++i) {
+            const cctable_entry_t *entry = keys[i].entry;
+            frozen->entries[slots[i]] = (ccfrozen_entry_t){
+                .key_offset = key_offset,
+                .length = entry->length,
+                .value = entry->value,
+            };
+            memcpy(frozen->keys + key_offset, entry->key, entry->length + 1);
+            key_offset += entry->length + 1;
+        }
+    } else {
+        CCWARN("could not find a perfect hash for %zu keys", size);
+        ccfrozen_deinit(frozen);
+    }
+
+    cc_free(fill);
+    cc_free(taken);
+    cc_free(slots);
+    cc_free(order);
+    cc_free(offsets);
+    cc_free(keys);
+    return placed;
+}
+
+void ccfrozen_deinit(ccfrozen_table_t *frozen) {
+    CCASSERT(frozen);
+    cc_free_with(frozen->allocator, frozen->entries, frozen->memory_size);
+    frozen->entries = NULL;
+    frozen->pilots = NULL;
+    frozen->keys = NULL;
+    frozen->size = 0;
+    frozen->bucket_count = 0;
+    frozen->memory_size = 0;
+}
+
+void *ccfrozen_get(const ccfrozen_table_t *frozen, const char *key) {
+    CCASSERT(key);
+    return ccfrozen_get_n(frozen, key, strlen(key));
+}
+
+void *ccfrozen_get_n(const ccfrozen_table_t *frozen, const char *key, size_t length) {
+    CCASSERT(frozen);
+    CCASSERT(key);
+    if(!frozen->size) return NULL;
+
+    uint64_t hash = cc_hash_bytes(key, length, 0);
+    uint32_t pilot = frozen->pilots[phash_bucket(hash, frozen->bucket_count)];
+    size_t slot = phash_slot(hash, frozen->seed, pilot, frozen->size);
+
+    const ccfrozen_entry_t *entry = &frozen->entries[slot];
+    if(entry->length != length) return NULL;
+    return memcmp(frozen->keys + entry->key_offset, key, length) ? NULL : entry->value;
+}
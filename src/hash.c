@@ -0,0 +1,111 @@
+//===--------------------------------------------------------------------------------------------===
+// hash.c - Non-cryptographic hash functions
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/hash.h>
+#include <ccore/log.h>
+#include <string.h>
+
+// Based on wyhash by Wang Yi (public domain, https://github.com/wangyi-fudan/wyhash): input is
+// consumed in 16 or 48 byte blocks, each folded into the state with a 64x64->128 bit multiply.
+
+static const uint64_t secret[4] = {
+    0xa0761d6478bd642full,
+    0xe7037ed1a0b428dbull,
+    0x8ebc6af09c88c6e3ull,
+    0x589965cc75374cc3ull,
+};
+
+static inline void mum(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+static inline uint64_t mix(uint64_t a, uint64_t b) {
+    mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t read64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Reads 1 to 3 bytes, hitting the first, middle and last byte.
+static inline uint64_t read_small(const uint8_t *p, size_t k) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+uint64_t cc_hash_bytes(const void *data, size_t length, uint64_t seed) {
+    CCASSERT(data || !length);
+    const uint8_t *p = data;
+    uint64_t a, b;
+
+    seed ^= mix(seed ^ secret[0], secret[1]);
+    if(length <= 16) {
+        if(length >= 4) {
+            size_t offset = (length >> 3) << 2;
+            a = (read32(p) << 32) | read32(p + offset);
+            b = (read32(p + length - 4) << 32) | read32(p + length - 4 - offset);
+        } else if(length > 0) {
+            a = read_small(p, length);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = length;
+        if(i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+                see1 = mix(read64(p + 16) ^ secret[2], read64(p + 24) ^ see1);
+                see2 = mix(read64(p + 32) ^ secret[3], read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while(i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while(i > 16) {
+            seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    mum(&a, &b);
+    return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+uint64_t cc_hash_str(const char *str, uint64_t seed) {
+    CCASSERT(str);
+    return cc_hash_bytes(str, strlen(str), seed);
+}
@@ -0,0 +1,221 @@
+//===--------------------------------------------------------------------------------------------===
+// heapprof - sampling heap profiler
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include "heapprof.h"
+#include <ccore/memory.h>
+#include <ccore/debug.h>
+#include <ccore/log.h>
+#include <ccore/string.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !WIN32
+#include <execinfo.h>
+#endif
+
+// Each thread counts down the bytes it allocates, and records the stack of the allocation that
+// crosses zero. The distance to the next sample is drawn from an exponential distribution, so
+// that sampling is unbiased by allocation patterns; a sample of [size] bytes then stands for
+// size / (1 - exp(-size/period)) bytes when the profile is written.
+//
+// Live samples are kept in a fixed-size table keyed by address. Each address may only live in
+// the CC_HEAP_PROFILE_PROBE slots following its hash, so that frees of unsampled blocks (the vast
+// majority) scan a bounded window. Slots are claimed and released with CAS, without locks.
+
+#define SLOT_EMPTY ((uintptr_t)0)
+#define SLOT_BUSY ((uintptr_t)1)
+#define PROBE (16)
+
+typedef struct {
+    size_t size;
+    int depth;
+    void *frames[CC_HEAP_PROFILE_MAX_DEPTH];
+} sample_t;
+
+atomic_bool heapprof_active;
+atomic_size_t heapprof_live_samples;
+
+static atomic_size_t sample_period;
+static atomic_uint_least64_t dropped_samples;
+static _Atomic uintptr_t keys[CC_HEAP_PROFILE_MAX_SAMPLES];
+static sample_t samples[CC_HEAP_PROFILE_MAX_SAMPLES];
+
+static _Thread_local int64_t bytes_until_sample;
+static _Thread_local uint64_t rng_state;
+static _Thread_local bool in_profiler;
+
+static char *exit_path = NULL;
+
+static inline uint64_t next_random(void) {
+    if(!rng_state) rng_state = ((uintptr_t)&rng_state) | 1;
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+}
+
+static int64_t next_sample_distance(size_t period) {
+    double u = ((next_random() >> 11) + 1) * (1.0 / 9007199254740993.0);
+    return (int64_t)(-log(u) * (double)period) + 1;
+}
+
+static inline size_t slot_for(uintptr_t ptr) {
+    return ((ptr >> 4) * 0x9e3779b97f4a7c15ULL) >> 40;
+}
+
+static void record(void *ptr, const sample_t *sample) {
+    uintptr_t key = (uintptr_t)ptr;
+    size_t mask = CC_HEAP_PROFILE_MAX_SAMPLES - 1;
+    size_t home = slot_for(key);
+
+    for(size_t i = 0; i < PROBE; ++i) {
+        size_t idx = (home + i) & mask;
+        uintptr_t expected = SLOT_EMPTY;
+        if(!atomic_compare_exchange_strong(&keys[idx], &expected, SLOT_BUSY)) continue;
+
+        samples[idx] = *sample;
+        atomic_store_explicit(&keys[idx], key, memory_order_release);
+        atomic_fetch_add_explicit(&heapprof_live_samples, 1, memory_order_relaxed);
+        return;
+    }
+    atomic_fetch_add_explicit(&dropped_samples, 1, memory_order_relaxed);
+}
+
+void heapprof_alloc(void *ptr, size_t size) {
+    if(!ptr || in_profiler) return;
+    size_t period = atomic_load_explicit(&sample_period, memory_order_relaxed);
+
+    if(!bytes_until_sample) bytes_until_sample = next_sample_distance(period);
+    bytes_until_sample -= size;
+    if(bytes_until_sample > 0) return;
+
+    in_profiler = true;
+    bytes_until_sample = next_sample_distance(period);
+
+    sample_t sample;
+    sample.size = size;
+    // Skip this function and the cc_alloc() entry point that called it.
+    sample.depth = cc_capture_stack(sample.frames, CC_HEAP_PROFILE_MAX_DEPTH, 2);
+    record(ptr, &sample);
+    in_profiler = false;
+}
+
+void heapprof_free(void *ptr) {
+    if(!ptr) return;
+    uintptr_t key = (uintptr_t)ptr;
+    size_t mask = CC_HEAP_PROFILE_MAX_SAMPLES - 1;
+    size_t home = slot_for(key);
+
+    for(size_t i = 0; i < PROBE; ++i) {
+        size_t idx = (home + i) & mask;
+        if(atomic_load_explicit(&keys[idx], memory_order_relaxed) != key) continue;
+
+        uintptr_t expected = key;
+        if(!atomic_compare_exchange_strong(&keys[idx], &expected, SLOT_BUSY)) return;
+        atomic_store_explicit(&keys[idx], SLOT_EMPTY, memory_order_release);
+        atomic_fetch_sub_explicit(&heapprof_live_samples, 1, memory_order_relaxed);
+        return;
+    }
+}
+
+void cc_heap_profile_start(size_t period) {
+    CCASSERT(period);
+    atomic_store(&sample_period, period);
+    atomic_store(&heapprof_active, true);
+}
+
+void cc_heap_profile_stop(void) {
+    atomic_store(&heapprof_active, false);
+}
+
+// Turns a symbol from backtrace_symbols() ("binary(function+0x10) [0x1234]") into a frame name
+// that can be used in a folded stack: the function name if there is one, the address otherwise.
+static void write_frame(FILE *out, const char *symbol, void *address) {
+    const char *start = symbol ? strchr(symbol, '(') : NULL;
+    const char *end = start ? strpbrk(start, "+)") : NULL;
+    if(!start || !end || end == start + 1) {
+        fprintf(out, "%p", address);
+        return;
+    }
+    for(const char *c = start + 1; c < end; ++c) {
+        fputc(*c == ' ' || *c == ';' ? '_' : *c, out);
+    }
+}
+
+static bool write_profile(FILE *out) {
+    size_t period = atomic_load(&sample_period);
+    uint64_t written = 0;
+    double total = 0;
+
+    for(size_t i = 0; i < CC_HEAP_PROFILE_MAX_SAMPLES; ++i) {
+        uintptr_t key = atomic_load_explicit(&keys[i], memory_order_acquire);
+        if(key == SLOT_EMPTY || key == SLOT_BUSY) continue;
+
+        sample_t sample = samples[i];
+        if(atomic_load_explicit(&keys[i], memory_order_acquire) != key) continue;
+
+        double scale = 1.0 / (1.0 - exp(-(double)sample.size / (double)period));
+        double bytes = (double)sample.size * scale;
+
+#if WIN32
+        char **symbols = NULL;
+#else
+        char **symbols = backtrace_symbols(sample.frames, sample.depth);
+#endif
+        for(int f = sample.depth - 1; f >= 0; --f) {
+            write_frame(out, symbols ? symbols[f] : NULL, sample.frames[f]);
+            if(f) fputc(';', out);
+        }
+        fprintf(out, " %.0f\n", bytes);
+        free(symbols);
+
+        written += 1;
+        total += bytes;
+    }
+    CCDEBUG("heap profile: %llu samples, ~%.0f live bytes, %llu dropped",
+        (unsigned long long)written, total,
+        (unsigned long long)atomic_load(&dropped_samples));
+    return !ferror(out);
+}
+
+bool cc_heap_profile_write(const char *path) {
+    CCASSERT(path);
+    FILE *out = fopen(path, "w");
+    if(!out) {
+        CCERROR("unable to write heap profile to `%s`", path);
+        return false;
+    }
+
+    in_profiler = true;
+    bool success = write_profile(out);
+    in_profiler = false;
+    fclose(out);
+    return success;
+}
+
+static void write_at_exit(void) {
+    if(exit_path) cc_heap_profile_write(exit_path);
+}
+
+// The path is copied, since callers may pass a buffer that is gone by the time the process exits.
+// The copy is made outside of sampling so that it doesn't show up in the profile.
+void cc_heap_profile_write_at_exit(const char *path) {
+    CCASSERT(path);
+    static bool registered = false;
+    in_profiler = true;
+    if(exit_path) cc_free(exit_path);
+    exit_path = string_duplicate(path);
+    in_profiler = false;
+    if(registered) return;
+    registered = true;
+    atexit(write_at_exit);
+}
@@ -0,0 +1,28 @@
+//===--------------------------------------------------------------------------------------------===
+// heapprof - private header for the sampling heap profiler
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+extern atomic_bool heapprof_active;
+extern atomic_size_t heapprof_live_samples;
+
+void heapprof_alloc(void *ptr, size_t size);
+void heapprof_free(void *ptr);
+
+// The hooks are called on every allocation, so keep the disabled path to a single load. They are
+// macros rather than inline functions so that they never show up as a frame in samples.
+#define HEAPPROF_ON_ALLOC(ptr, size) do { \
+    if(atomic_load_explicit(&heapprof_active, memory_order_relaxed)) heapprof_alloc((ptr), (size)); \
+} while(0)
+
+#define HEAPPROF_ON_FREE(ptr) do { \
+    if(atomic_load_explicit(&heapprof_live_samples, memory_order_relaxed)) heapprof_free((ptr)); \
+} while(0)
@@ -0,0 +1,235 @@
+//===--------------------------------------------------------------------------------------------===
+// index - open-addressing index shared by hash tables
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include "index.h"
+#include <ccore/log.h>
+#include <string.h>
+
+// Entries moved from the old slots to the new ones on each insert while the index grows. Moving at
+// least one per insert is enough to finish before the new slots fill up.
+#define REHASH_STEP (16)
+
+// Slots are a single allocation: [capacity] entry positions, followed by the control bytes.
+static inline size_t slots_size(size_t capacity) {
+    return capacity * sizeof(uint32_t) + capacity + CC_SWISS_GROUP_SIZE;
+}
+
+static void slots_alloc(cchash_slots_t *slots, size_t capacity, const cc_allocator_t *allocator) {
+    CCASSERT(capacity <= UINT32_MAX);
+    slots->capacity = capacity;
+    slots->positions = cc_alloc_with(allocator, slots_size(capacity));
+    slots->ctrl = (uint8_t *)(slots->positions + capacity);
+    memset(slots->ctrl, CC_SWISS_EMPTY, capacity + CC_SWISS_GROUP_SIZE);
+}
+
+static void slots_free(cchash_slots_t *slots, const cc_allocator_t *allocator) {
+    if(slots->capacity) cc_free_with(allocator, slots->positions, slots_size(slots->capacity));
+    slots->positions = NULL;
+    slots->ctrl = NULL;
+    slots->capacity = 0;
+}
+
+static void slots_put(cchash_slots_t *slots, size_t hash, uint32_t position) {
+    size_t slot = ccswiss_find_free(slots->ctrl, slots->capacity, hash);
+    ccswiss_set_ctrl(slots->ctrl, slots->capacity, slot, ccswiss_h2(hash));
+    slots->positions[slot] = position;
+}
+
+// Removed slots become tombstones, so that probe sequences going through them are not cut short.
+static void slots_erase(cchash_slots_t *slots, size_t hash, size_t position) {
+    uint8_t h2 = ccswiss_h2(hash);
+    ccswiss_probe_t probe = ccswiss_probe_start(hash, slots->capacity);
+    for(;;) {
+        const uint8_t *group = slots->ctrl + probe.pos;
+        for(ccswiss_mask_t match = ccswiss_match(group, h2); match; match &= match - 1) {
+            size_t slot = ccswiss_probe_slot(&probe, ccswiss_first(match));
+            if(slots->positions[slot] != position) continue;
+            ccswiss_set_ctrl(slots->ctrl, slots->capacity, slot, CC_SWISS_DELETED);
+            return;
+        }
+        if(ccswiss_match_empty(group)) return;
+        ccswiss_probe_next(&probe);
+    }
+}
+
+static inline const void *entry_at(const ccvec_base_t *entries, const index_ops_t *ops, size_t i) {
+    return (const unsigned char *)entries->data + i * ops->entry_size;
+}
+
+static inline bool index_is_rehashing(const cchash_index_t *index) {
+    return index->old_slots.capacity != 0;
+}
+
+// Moves up to [count] entries that are only in the old slots to the new ones, and drops the old
+// slots once they have all been moved.
+static void rehash_step(
+    cchash_index_t *index,
+    const ccvec_base_t *entries,
+    const index_ops_t *ops,
+    size_t count
+) {
+    size_t end = index->rehash_pos + count;
+    if(end > index->rehash_end) end = index->rehash_end;
+
+    for(size_t i = index->rehash_pos; i < end; ++i) {
+        size_t hash;
+        if(ops->entry_hash(entry_at(entries, ops, i), &hash)) slots_put(&index->slots, hash, i);
+    }
+    index->rehash_pos = end;
+    if(end == index->rehash_end) slots_free(&index->old_slots, index->allocator);
+}
+
+static void rehash_finish(
+    cchash_index_t *index,
+    const ccvec_base_t *entries,
+    const index_ops_t *ops
+) {
+    if(index_is_rehashing(index)) rehash_step(index, entries, ops, index->rehash_end);
+}
+
+// Swaps in empty slots of [capacity]. Existing entries are moved to them by later calls to
+// rehash_step().
+static void rehash_start(
+    cchash_index_t *index,
+    const ccvec_base_t *entries,
+    const index_ops_t *ops,
+    size_t capacity
+) {
+    rehash_finish(index, entries, ops);
+    index->old_slots = index->slots;
+    index->rehash_pos = 0;
+    index->rehash_end = entries->count;
+    slots_alloc(&index->slots, capacity, index->allocator);
+}
+
+// Drops the holes left in [entries] by removals, and rebuilds slots of [capacity] for the
+// remaining entries.
+static void compact(
+    cchash_index_t *index,
+    ccvec_base_t *entries,
+    const index_ops_t *ops,
+    size_t capacity
+) {
+    rehash_finish(index, entries, ops);
+    slots_free(&index->slots, index->allocator);
+    slots_alloc(&index->slots, capacity, index->allocator);
+
+    size_t live = 0;
+    size_t entry_size = ops->entry_size;
+    unsigned char *data = entries->data;
+    for(size_t i = 0; i < entries->count; ++i) {
+        size_t hash;
+        if(!ops->entry_hash(entry_at(entries, ops, i), &hash)) continue;
+        if(live != i) memcpy(data + live * entry_size, data + i * entry_size, entry_size);
+        slots_put(&index->slots, hash, live++);
+    }
+    entries->count = live;
+    index->removed = 0;
+}
+
+void index_init(cchash_index_t *index, size_t count, const cc_allocator_t *allocator) {
+    CCASSERT(index);
+    index->allocator = allocator;
+    index->old_slots = (cchash_slots_t){0, NULL, NULL};
+    index->rehash_pos = 0;
+    index->rehash_end = 0;
+    index->removed = 0;
+    slots_alloc(&index->slots, ccswiss_capacity_for(count), allocator);
+}
+
+void index_deinit(cchash_index_t *index) {
+    CCASSERT(index);
+    slots_free(&index->slots, index->allocator);
+    slots_free(&index->old_slots, index->allocator);
+    index->rehash_pos = 0;
+    index->rehash_end = 0;
+    index->removed = 0;
+}
+
+void index_reserve(
+    cchash_index_t *index,
+    ccvec_base_t *entries,
+    const index_ops_t *ops,
+    size_t count
+) {
+    CCASSERT(index);
+    ccvec_reserve(entries, ops->entry_size, count);
+
+    size_t capacity = ccswiss_capacity_for(count);
+    if(capacity <= index->slots.capacity) return;
+    compact(index, entries, ops, capacity);
+}
+
+void index_step(cchash_index_t *index, const ccvec_base_t *entries, const index_ops_t *ops) {
+    if(index_is_rehashing(index)) rehash_step(index, entries, ops, REHASH_STEP);
+}
+
+// Every entry, including removed ones, holds a slot until the next rebuild, so the entry count is
+// what decides when the index is full. If enough of them are holes, the entries are compacted in
+// place rather than the index grown.
+size_t index_add(
+    cchash_index_t *index,
+    ccvec_base_t *entries,
+    const index_ops_t *ops,
+    size_t hash
+) {
+    if(entries->count + 1 > CC_SWISS_MAX_LOAD(index->slots.capacity)) {
+        if(index->removed >= entries->count / 4) {
+            compact(index, entries, ops, index->slots.capacity);
+        } else {
+            rehash_start(index, entries, ops, index->slots.capacity * 2);
+        }
+    }
+    size_t position = entries->count;
+    slots_put(&index->slots, hash, position);
+    return position;
+}
+
+void index_remove(cchash_index_t *index, size_t hash, size_t position) {
+    slots_erase(&index->slots, hash, position);
+    if(index_is_rehashing(index)) slots_erase(&index->old_slots, hash, position);
+    index->removed += 1;
+}
+
+// Adds the groups probed in [slots] to [length], and returns whether the entry was found.
+static bool slots_probe_length(
+    const cchash_slots_t *slots,
+    size_t hash,
+    size_t position,
+    size_t *length
+) {
+    uint8_t h2 = ccswiss_h2(hash);
+    ccswiss_probe_t probe = ccswiss_probe_start(hash, slots->capacity);
+    for(;;) {
+        const uint8_t *group = slots->ctrl + probe.pos;
+        *length += 1;
+        for(ccswiss_mask_t match = ccswiss_match(group, h2); match; match &= match - 1) {
+            size_t slot = ccswiss_probe_slot(&probe, ccswiss_first(match));
+            if(slots->positions[slot] == position) return true;
+        }
+        if(ccswiss_match_empty(group)) return false;
+        ccswiss_probe_next(&probe);
+    }
+}
+
+size_t index_probe_length(const cchash_index_t *index, size_t hash, size_t position) {
+    size_t length = 0;
+    if(slots_probe_length(&index->slots, hash, position, &length)) return length;
+    if(index_is_rehashing(index)) slots_probe_length(&index->old_slots, hash, position, &length);
+    return length;
+}
+
+size_t index_count_ctrl(const cchash_slots_t *slots, uint8_t ctrl) {
+    size_t count = 0;
+    for(size_t i = 0; i < slots->capacity; ++i) count += slots->ctrl[i] == ctrl;
+    return count;
+}
+
+size_t index_slots_size(const cchash_slots_t *slots) {
+    return slots->capacity ? slots_size(slots->capacity) : 0;
+}
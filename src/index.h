@@ -0,0 +1,97 @@
+//===--------------------------------------------------------------------------------------------===
+// index - private header for the open-addressing index shared by hash tables
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <ccore/array.h>
+#include <ccore/table.h>
+#include <ccore/swiss.h>
+
+// Tables using the index keep their entries in a ccvec_base_t, and describe them with index_ops_t
+// so the index can rebuild itself. Lookups take the comparison function directly: index_find()
+// is inline so that it can be specialised for each kind of key.
+
+#define INDEX_NOT_FOUND (SIZE_MAX)
+
+typedef struct index_ops_s {
+    size_t entry_size;
+    // Returns false if [entry] was removed; otherwise, stores the hash of its key in [hash].
+    bool (*entry_hash)(const void *entry, size_t *hash);
+} index_ops_t;
+
+// Returns whether the entry at [entry] has the key at [key].
+typedef bool (*index_equals_f)(const void *entry, const void *key);
+
+void index_init(cchash_index_t *index, size_t count, const cc_allocator_t *allocator);
+void index_deinit(cchash_index_t *index);
+
+// Rebuilds [index] so it can hold [count] entries, compacting [entries] on the way.
+void index_reserve(
+    cchash_index_t *index,
+    ccvec_base_t *entries,
+    const index_ops_t *ops,
+    size_t count
+);
+
+// Moves a few entries to the new slots if the index is growing. Called before each insertion.
+void index_step(cchash_index_t *index, const ccvec_base_t *entries, const index_ops_t *ops);
+
+// Makes room for one more entry, growing or compacting [entries] and the index if needed, and
+// maps [hash] to the position at which the caller must then push the new entry.
+size_t index_add(
+    cchash_index_t *index,
+    ccvec_base_t *entries,
+    const index_ops_t *ops,
+    size_t hash
+);
+
+// Unmaps the entry at [position], which has [hash]. The caller leaves a hole in its entry array.
+void index_remove(cchash_index_t *index, size_t hash, size_t position);
+
+// Returns the number of groups a lookup probes to find the entry at [position], which has [hash].
+size_t index_probe_length(const cchash_index_t *index, size_t hash, size_t position);
+
+// Returns the number of slots in [slots] whose control byte is [ctrl].
+size_t index_count_ctrl(const cchash_slots_t *slots, uint8_t ctrl);
+
+// Returns the number of bytes allocated for [slots].
+size_t index_slots_size(const cchash_slots_t *slots);
+
+static inline size_t index_probe(
+    const cchash_slots_t *slots,
+    const unsigned char *entries,
+    size_t entry_size,
+    size_t hash,
+    index_equals_f equals,
+    const void *key
+) {
+    uint8_t h2 = ccswiss_h2(hash);
+    ccswiss_probe_t probe = ccswiss_probe_start(hash, slots->capacity);
+    for(;;) {
+        const uint8_t *group = slots->ctrl + probe.pos;
+        for(ccswiss_mask_t match = ccswiss_match(group, h2); match; match &= match - 1) {
+            size_t position = slots->positions[ccswiss_probe_slot(&probe, ccswiss_first(match))];
+            if(equals(entries + position * entry_size, key)) return position;
+        }
+        if(ccswiss_match_empty(group)) return INDEX_NOT_FOUND;
+        ccswiss_probe_next(&probe);
+    }
+}
+
+// Returns the position of the entry with [key] and [hash], or INDEX_NOT_FOUND.
+static inline size_t index_find(
+    const cchash_index_t *index,
+    const void *entries,
+    size_t entry_size,
+    size_t hash,
+    index_equals_f equals,
+    const void *key
+) {
+    size_t position = index_probe(&index->slots, entries, entry_size, hash, equals, key);
+    if(position != INDEX_NOT_FOUND || !index->old_slots.capacity) return position;
+    return index_probe(&index->old_slots, entries, entry_size, hash, equals, key);
+}
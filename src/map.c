@@ -0,0 +1,142 @@
+//===--------------------------------------------------------------------------------------------===
+// map.c - Hash maps keyed by integers
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/map.h>
+#include <ccore/hash.h>
+#include <ccore/log.h>
+#include "index.h"
+
+// Every key is valid, so removed entries are marked by pointing their value to this instead.
+static char hole;
+#define MAP_HOLE ((void *)&hole)
+
+static inline bool u64_is_hole(const ccmap_u64_entry_t *entry) {
+    return entry->value == MAP_HOLE;
+}
+
+static inline bool u64_equals(const void *ptr, const void *key) {
+    return ((const ccmap_u64_entry_t *)ptr)->key == *(const uint64_t *)key;
+}
+
+static bool u64_entry_hash(const void *ptr, size_t *hash) {
+    const ccmap_u64_entry_t *entry = ptr;
+    if(u64_is_hole(entry)) return false;
+    *hash = cc_hash_u64(entry->key);
+    return true;
+}
+
+static const index_ops_t u64_ops = {sizeof(ccmap_u64_entry_t), u64_entry_hash};
+
+static ccmap_u64_entry_t *u64_find(const ccmap_u64_t *map, uint64_t key, size_t hash) {
+    size_t position = index_find(
+        &map->index,
+        map->entries.data,
+        sizeof(ccmap_u64_entry_t),
+        hash,
+        u64_equals,
+        &key
+    );
+    return position != INDEX_NOT_FOUND ? &map->entries.data[position] : NULL;
+}
+
+static ccmap_u64_entry_t *u64_add(ccmap_u64_t *map, uint64_t key, size_t hash) {
+    size_t position = index_add(&map->index, &map->entries.base, &u64_ops, hash);
+    CC_VEC_PUSH(&map->entries, ((ccmap_u64_entry_t){key, NULL}));
+    map->size += 1;
+    return &map->entries.data[position];
+}
+
+void ccmap_u64_init(ccmap_u64_t *map, size_t count) {
+    ccmap_u64_init_with(map, count, NULL);
+}
+
+void ccmap_u64_init_with(ccmap_u64_t *map, size_t count, const cc_allocator_t *allocator) {
+    CCASSERT(map);
+    map->size = 0;
+    index_init(&map->index, count, allocator);
+    CC_VEC_INIT_WITH(&map->entries, allocator);
+    CC_VEC_RESERVE(&map->entries, count);
+}
+
+void ccmap_u64_deinit(ccmap_u64_t *map, cc_destructor des, void *user_data) {
+    CCASSERT(map);
+    if(des) {
+        for(size_t i = 0; i < map->entries.count; ++i) {
+            ccmap_u64_entry_t *entry = &map->entries.data[i];
+            if(!u64_is_hole(entry)) des(entry->value, user_data);
+        }
+    }
+    CC_VEC_DEINIT(&map->entries);
+    index_deinit(&map->index);
+    map->size = 0;
+}
+
+void ccmap_u64_reserve(ccmap_u64_t *map, size_t count) {
+    CCASSERT(map);
+    index_reserve(&map->index, &map->entries.base, &u64_ops, count);
+}
+
+void ccmap_u64_insert(ccmap_u64_t *map, uint64_t key, void *value) {
+    CCASSERT(map);
+    index_step(&map->index, &map->entries.base, &u64_ops);
+
+    size_t hash = cc_hash_u64(key);
+    if(u64_find(map, key, hash)) return;
+    u64_add(map, key, hash)->value = value;
+}
+
+void **ccmap_u64_upsert(ccmap_u64_t *map, uint64_t key, bool *inserted) {
+    CCASSERT(map);
+    index_step(&map->index, &map->entries.base, &u64_ops);
+
+    size_t hash = cc_hash_u64(key);
+    ccmap_u64_entry_t *entry = u64_find(map, key, hash);
+    if(inserted) *inserted = !entry;
+    if(!entry) entry = u64_add(map, key, hash);
+    return &entry->value;
+}
+
+void *ccmap_u64_get(const ccmap_u64_t *map, uint64_t key) {
+    CCASSERT(map);
+    const ccmap_u64_entry_t *entry = u64_find(map, key, cc_hash_u64(key));
+    return entry ? entry->value : NULL;
+}
+
+bool ccmap_u64_contains(const ccmap_u64_t *map, uint64_t key) {
+    CCASSERT(map);
+    return u64_find(map, key, cc_hash_u64(key)) != NULL;
+}
+
+bool ccmap_u64_remove(ccmap_u64_t *map, uint64_t key, cc_destructor des, void *user_data) {
+    CCASSERT(map);
+
+    size_t hash = cc_hash_u64(key);
+    ccmap_u64_entry_t *entry = u64_find(map, key, hash);
+    if(!entry) return false;
+
+    index_remove(&map->index, hash, entry - map->entries.data);
+    if(des) des(entry->value, user_data);
+    entry->value = MAP_HOLE;
+    map->size -= 1;
+    return true;
+}
+
+ccmap_u64_cursor_t ccmap_u64_cursor(const ccmap_u64_t *map) {
+    CCASSERT(map);
+    return (ccmap_u64_cursor_t){map, 0};
+}
+
+const ccmap_u64_entry_t *ccmap_u64_next(ccmap_u64_cursor_t *cursor) {
+    CCASSERT(cursor);
+    const ccmap_u64_t *map = cursor->map;
+    while(cursor->position < map->entries.count) {
+        const ccmap_u64_entry_t *entry = &map->entries.data[cursor->position++];
+        if(!u64_is_hole(entry)) return entry;
+    }
+    return NULL;
+}
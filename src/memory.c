@@ -8,7 +8,18 @@
 //===--------------------------------------------------------------------------------------------===
 #include <ccore/memory.h>
 #include <ccore/log.h>
+#include "tcache.h"
+#include "memstats.h"
+#include "heapprof.h"
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#if WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
 
 static void *cc_default_alloc(void *ptr, size_t size) {
     if(!size) {
@@ -30,14 +41,462 @@ void cc_set_allocator(cc_allocator allocator) {
     __cc_alloc = allocator;
 }
 
-void *cc_alloc(size_t size) {
+void *cc_backend_alloc(void *ptr, size_t size) {
+    return __cc_alloc(ptr, size);
+}
+
+// Allocations go through up to two optional layers: statistics (CC_MEM_STATS), then the
+// thread-local cache (CC_TCACHE), and finally the allocator installed with cc_set_allocator().
+
+static inline void *raw_alloc(size_t size) {
+#ifdef CC_TCACHE
+    return tcache_alloc(size);
+#else
     return __cc_alloc(NULL, size);
+#endif
 }
 
-void cc_free(void *ptr) {
+static inline void *raw_realloc(void *ptr, size_t size) {
+#ifdef CC_TCACHE
+    return tcache_realloc(ptr, size);
+#else
+    return __cc_alloc(ptr, size);
+#endif
+}
+
+static inline void raw_free(void *ptr) {
+#ifdef CC_TCACHE
+    tcache_free(ptr);
+#else
     __cc_alloc(ptr, 0);
+#endif
 }
 
-void *cc_realloc(void *ptr, size_t size) {
-    return __cc_alloc(ptr, size);
+void *cc_raw_alloc(size_t size) {
+    return raw_alloc(size);
+}
+
+void *cc_raw_realloc(void *ptr, size_t size) {
+    return raw_realloc(ptr, size);
+}
+
+void cc_raw_free(void *ptr) {
+    raw_free(ptr);
+}
+
+#ifdef CC_MEM_STATS
+
+void *(cc_alloc)(size_t size) {
+    void *ptr = memstats_alloc(size, NULL, 0);
+    HEAPPROF_ON_ALLOC(ptr, size);
+    return ptr;
+}
+
+void cc_free(void *ptr) {
+    HEAPPROF_ON_FREE(ptr);
+    memstats_free(ptr);
+}
+
+void *(cc_realloc)(void *ptr, size_t size) {
+    HEAPPROF_ON_FREE(ptr);
+    ptr = memstats_realloc(ptr, size, NULL, 0);
+    HEAPPROF_ON_ALLOC(ptr, size);
+    return ptr;
+}
+
+void *cc_alloc_site(size_t size, const char *file, int line) {
+    void *ptr = memstats_alloc(size, file, line);
+    HEAPPROF_ON_ALLOC(ptr, size);
+    return ptr;
+}
+
+void *cc_realloc_site(void *ptr, size_t size, const char *file, int line) {
+    HEAPPROF_ON_FREE(ptr);
+    ptr = memstats_realloc(ptr, size, file, line);
+    HEAPPROF_ON_ALLOC(ptr, size);
+    return ptr;
+}
+
+#else
+
+void *(cc_alloc)(size_t size) {
+    void *ptr = raw_alloc(size);
+    HEAPPROF_ON_ALLOC(ptr, size);
+    return ptr;
+}
+
+void cc_free(void *ptr) {
+    HEAPPROF_ON_FREE(ptr);
+    raw_free(ptr);
+}
+
+void *(cc_realloc)(void *ptr, size_t size) {
+    HEAPPROF_ON_FREE(ptr);
+    ptr = raw_realloc(ptr, size);
+    HEAPPROF_ON_ALLOC(ptr, size);
+    return ptr;
+}
+
+void *cc_alloc_site(size_t size, const char *file, int line) {
+    CCUNUSED(file);
+    CCUNUSED(line);
+    void *ptr = raw_alloc(size);
+    HEAPPROF_ON_ALLOC(ptr, size);
+    return ptr;
+}
+
+void *cc_realloc_site(void *ptr, size_t size, const char *file, int line) {
+    CCUNUSED(file);
+    CCUNUSED(line);
+    HEAPPROF_ON_FREE(ptr);
+    ptr = raw_realloc(ptr, size);
+    HEAPPROF_ON_ALLOC(ptr, size);
+    return ptr;
+}
+
+#endif
+
+static void *default_alloc(void *ctx, size_t size) {
+    CCUNUSED(ctx);
+    return cc_alloc(size);
+}
+
+static void *default_realloc(void *ctx, void *ptr, size_t old_size, size_t size) {
+    CCUNUSED(ctx);
+    CCUNUSED(old_size);
+    return cc_realloc(ptr, size);
+}
+
+static void default_free(void *ctx, void *ptr, size_t size) {
+    CCUNUSED(ctx);
+    CCUNUSED(size);
+    cc_free(ptr);
+}
+
+static const cc_allocator_t default_allocator = {
+    .alloc = default_alloc,
+    .realloc = default_realloc,
+    .free = default_free,
+    .ctx = NULL,
+};
+
+const cc_allocator_t *cc_default_allocator(void) {
+    return &default_allocator;
+}
+
+// MARK: - Aligned and page allocations
+
+static inline size_t align_up(size_t size, size_t align) {
+    return (size + align - 1) & ~(align - 1);
+}
+
+// Aligned blocks are over-allocated, and the pointer to the underlying block is stored in the
+// word right before the aligned pointer.
+static inline size_t aligned_block_size(size_t size, size_t align) {
+    return size + align - 1 + sizeof(void *);
+}
+
+static inline void *align_block(void *block, size_t align) {
+    uintptr_t start = align_up((uintptr_t)block + sizeof(void *), align);
+    ((void **)start)[-1] = block;
+    return (void *)start;
+}
+
+void *cc_alloc_aligned_with(const cc_allocator_t *allocator, size_t size, size_t align) {
+    CCASSERT(align && !(align & (align - 1)));
+    if(align < sizeof(void *)) align = sizeof(void *);
+    return align_block(cc_alloc_with(allocator, aligned_block_size(size, align)), align);
+}
+
+void cc_free_aligned_with(const cc_allocator_t *allocator, void *ptr, size_t size, size_t align) {
+    if(!ptr) return;
+    if(align < sizeof(void *)) align = sizeof(void *);
+    cc_free_with(allocator, ((void **)ptr)[-1], aligned_block_size(size, align));
+}
+
+void *cc_alloc_aligned(size_t size, size_t align) {
+    return cc_alloc_aligned_with(NULL, size, align);
+}
+
+void cc_free_aligned(void *ptr) {
+    if(!ptr) return;
+    cc_free(((void **)ptr)[-1]);
+}
+
+#if WIN32
+
+void *cc_alloc_pages(size_t size) {
+    void *ptr = VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    CCASSERT(ptr);
+    return ptr;
+}
+
+void cc_free_pages(void *ptr, size_t size) {
+    CCUNUSED(size);
+    if(ptr) VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
+#else
+
+// Buffers that can hold at least one huge page are mapped at a huge page boundary, so that the
+// kernel can back them with transparent huge pages from the start.
+void *cc_alloc_pages(size_t size) {
+    CCASSERT(size);
+    size = align_up(size, CC_PAGE_SIZE);
+    if(size < CC_HUGE_PAGE_SIZE) {
+        void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        CCASSERT(ptr != MAP_FAILED);
+        return ptr;
+    }
+
+    size_t mapped = size + CC_HUGE_PAGE_SIZE;
+    unsigned char *map = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    CCASSERT(map != MAP_FAILED);
+
+    unsigned char *start = (unsigned char *)align_up((uintptr_t)map, CC_HUGE_PAGE_SIZE);
+    size_t head = start - map;
+    size_t tail = mapped - head - size;
+    if(head) munmap(map, head);
+    if(tail) munmap(start + size, tail);
+
+#ifdef MADV_HUGEPAGE
+    madvise(start, size, MADV_HUGEPAGE);
+#endif
+    return start;
+}
+
+void cc_free_pages(void *ptr, size_t size) {
+    if(!ptr) return;
+    munmap(ptr, align_up(size, CC_PAGE_SIZE));
+}
+
+#endif
+
+// MARK: - Arena allocator
+
+struct cc_arena_chunk_s {
+    cc_arena_chunk_t *next;
+    size_t capacity;
+    size_t used;
+    max_align_t data[];
+};
+
+#define ARENA_ALIGN (_Alignof(max_align_t))
+
+static inline unsigned char *chunk_data(cc_arena_chunk_t *chunk) {
+    return (unsigned char *)chunk->data;
+}
+
+static void *arena_alloc(void *ctx, size_t size) {
+    return cc_arena_alloc(ctx, size);
+}
+
+static void *arena_realloc(void *ctx, void *ptr, size_t old_size, size_t size) {
+    return cc_arena_realloc(ctx, ptr, old_size, size);
+}
+
+// Arenas only reclaim memory on reset, except for the last allocation made, which is given back
+// by moving the bump pointer.
+static void arena_free(void *ctx, void *ptr, size_t size) {
+    cc_arena_t *arena = ctx;
+    cc_arena_chunk_t *chunk = arena->current;
+    size_t aligned = align_up(size ? size : 1, ARENA_ALIGN);
+    if(chunk && (unsigned char *)ptr + aligned == chunk_data(chunk) + chunk->used) {
+        chunk->used -= aligned;
+    }
+}
+
+void cc_arena_init(cc_arena_t *arena, size_t chunk_size) {
+    cc_arena_init_with(arena, chunk_size, NULL);
+}
+
+void cc_arena_init_with(cc_arena_t *arena, size_t chunk_size, const cc_allocator_t *parent) {
+    CCASSERT(arena);
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->chunk_size = chunk_size ? chunk_size : CC_ARENA_DEFAULT_CHUNK_SIZE;
+    arena->parent = parent;
+    arena->allocator.alloc = arena_alloc;
+    arena->allocator.realloc = arena_realloc;
+    arena->allocator.free = arena_free;
+    arena->allocator.ctx = arena;
+}
+
+const cc_allocator_t *cc_arena_allocator(cc_arena_t *arena) {
+    CCASSERT(arena);
+    return &arena->allocator;
+}
+
+void cc_arena_deinit(cc_arena_t *arena) {
+    CCASSERT(arena);
+    cc_arena_chunk_t *chunk = arena->first;
+    while(chunk) {
+        cc_arena_chunk_t *to_free = chunk;
+        chunk = chunk->next;
+        cc_free_with(arena->parent, to_free, sizeof(cc_arena_chunk_t) + to_free->capacity);
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+}
+
+// Moves the arena to a chunk that can fit at least [size] bytes. Chunks that are left over after
+// a reset or rewind are reused when they are big enough, otherwise a new one is chained in.
+static cc_arena_chunk_t *arena_next_chunk(cc_arena_t *arena, size_t size) {
+    cc_arena_chunk_t *current = arena->current;
+    cc_arena_chunk_t *next = current ? current->next : arena->first;
+
+    if(next && next->capacity >= size) {
+        next->used = 0;
+        arena->current = next;
+        return next;
+    }
+
+    size_t capacity = size > arena->chunk_size ? size : arena->chunk_size;
+    cc_arena_chunk_t *chunk = cc_alloc_with(arena->parent, sizeof(cc_arena_chunk_t) + capacity);
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    chunk->next = next;
+
+    if(current) {
+        current->next = chunk;
+    } else {
+        arena->first = chunk;
+    }
+    arena->current = chunk;
+    return chunk;
+}
+
+void *cc_arena_alloc(cc_arena_t *arena, size_t size) {
+    CCASSERT(arena);
+    size = align_up(size ? size : 1, ARENA_ALIGN);
+
+    cc_arena_chunk_t *chunk = arena->current;
+    if(!chunk || chunk->used + size > chunk->capacity) {
+        chunk = arena_next_chunk(arena, size);
+    }
+    void *ptr = chunk_data(chunk) + chunk->used;
+    chunk->used += size;
+    return ptr;
+}
+
+void *cc_arena_realloc(cc_arena_t *arena, void *ptr, size_t old_size, size_t size) {
+    CCASSERT(arena);
+    if(!ptr) return cc_arena_alloc(arena, size);
+
+    cc_arena_chunk_t *chunk = arena->current;
+    size_t old_aligned = align_up(old_size ? old_size : 1, ARENA_ALIGN);
+    size_t new_aligned = align_up(size ? size : 1, ARENA_ALIGN);
+
+    // If this is the last allocation made, we can just move the bump pointer.
+    if(chunk && (unsigned char *)ptr + old_aligned == chunk_data(chunk) + chunk->used) {
+        size_t start = chunk->used - old_aligned;
+        if(start + new_aligned <= chunk->capacity) {
+            chunk->used = start + new_aligned;
+            return ptr;
+        }
+    }
+
+    if(size <= old_size) return ptr;
+    void *new_ptr = cc_arena_alloc(arena, size);
+    memcpy(new_ptr, ptr, old_size);
+    return new_ptr;
+}
+
+cc_arena_mark_t cc_arena_mark(const cc_arena_t *arena) {
+    CCASSERT(arena);
+    cc_arena_mark_t mark;
+    mark.chunk = arena->current;
+    mark.used = arena->current ? arena->current->used : 0;
+    return mark;
+}
+
+void cc_arena_rewind(cc_arena_t *arena, cc_arena_mark_t mark) {
+    CCASSERT(arena);
+    if(!mark.chunk) return cc_arena_reset(arena);
+    CCASSERT(mark.used <= mark.chunk->capacity);
+    arena->current = mark.chunk;
+    arena->current->used = mark.used;
+}
+
+void cc_arena_reset(cc_arena_t *arena) {
+    CCASSERT(arena);
+    arena->current = arena->first;
+    if(arena->current) arena->current->used = 0;
+}
+
+// MARK: - Slab pools
+
+struct cc_pool_slab_s {
+    cc_pool_slab_t *next;
+    size_t size;
+};
+
+#define POOL_ALIGN (_Alignof(max_align_t))
+#define POOL_SLAB_HEADER (align_up(sizeof(cc_pool_slab_t), CC_CACHE_LINE_SIZE))
+#define POOL_FIRST_SLAB_CAPACITY (8)
+
+void cc_pool_init(cc_pool_t *pool, size_t object_size) {
+    cc_pool_init_with(pool, object_size, NULL);
+}
+
+void cc_pool_init_with(cc_pool_t *pool, size_t object_size, const cc_allocator_t *allocator) {
+    CCASSERT(pool);
+    CCASSERT(object_size);
+    if(object_size < sizeof(void *)) object_size = sizeof(void *);
+    pool->allocator = allocator;
+    pool->object_size = align_up(object_size, POOL_ALIGN);
+    pool->slab_capacity = POOL_FIRST_SLAB_CAPACITY;
+    pool->free_list = NULL;
+    pool->bump = NULL;
+    pool->bump_end = NULL;
+    pool->slabs = NULL;
+}
+
+void cc_pool_deinit(cc_pool_t *pool) {
+    CCASSERT(pool);
+    cc_pool_slab_t *slab = pool->slabs;
+    while(slab) {
+        cc_pool_slab_t *to_free = slab;
+        slab = slab->next;
+        cc_free_aligned_with(pool->allocator, to_free, to_free->size, CC_CACHE_LINE_SIZE);
+    }
+    cc_pool_init_with(pool, pool->object_size, pool->allocator);
+}
+
+// Slabs start small so that pools that only ever hold a couple of objects stay cheap, and double
+// in size until they reach CC_POOL_MAX_SLAB_SIZE.
+static void pool_add_slab(cc_pool_t *pool) {
+    size_t objects_size = pool->slab_capacity * pool->object_size;
+    size_t size = POOL_SLAB_HEADER + objects_size;
+
+    cc_pool_slab_t *slab = cc_alloc_aligned_with(pool->allocator, size, CC_CACHE_LINE_SIZE);
+    slab->size = size;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    pool->bump = (unsigned char *)slab + POOL_SLAB_HEADER;
+    pool->bump_end = pool->bump + objects_size;
+
+    if(objects_size * 2 <= CC_POOL_MAX_SLAB_SIZE) pool->slab_capacity *= 2;
+}
+
+void *cc_pool_alloc(cc_pool_t *pool) {
+    CCASSERT(pool);
+    if(pool->free_list) {
+        void *ptr = pool->free_list;
+        pool->free_list = *(void **)ptr;
+        return ptr;
+    }
+
+    if(pool->bump == pool->bump_end) pool_add_slab(pool);
+    void *ptr = pool->bump;
+    pool->bump += pool->object_size;
+    return ptr;
+}
+
+void cc_pool_free(cc_pool_t *pool, void *ptr) {
+    CCASSERT(pool);
+    if(!ptr) return;
+    *(void **)ptr = pool->free_list;
+    pool->free_list = ptr;
 }
@@ -0,0 +1,274 @@
+//===--------------------------------------------------------------------------------------------===
+// memstats - allocation statistics and per-call-site accounting
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include "memstats.h"
+#include <ccore/memory.h>
+#include <ccore/log.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef CC_MEM_STATS
+
+// Every block is prefixed with a header recording its size and the call site it is attributed
+// to, so that frees can be accounted for without the caller passing the size.
+
+#define NO_SITE (UINT32_MAX)
+
+typedef struct {
+    size_t size;
+    uint32_t site;
+} header_t;
+
+#define HEADER_SIZE \
+    ((sizeof(header_t) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+
+enum { SITE_EMPTY, SITE_CLAIMED, SITE_READY };
+
+typedef struct {
+    atomic_int state;
+    const char *file;
+    int line;
+    atomic_size_t live_bytes;
+    atomic_size_t live_blocks;
+    atomic_uint_least64_t allocs;
+    atomic_uint_least64_t total_bytes;
+} site_t;
+
+static atomic_size_t live_bytes;
+static atomic_size_t peak_bytes;
+static atomic_size_t live_blocks;
+static atomic_uint_least64_t allocs;
+static atomic_uint_least64_t reallocs;
+static atomic_uint_least64_t frees;
+static atomic_uint_least64_t histogram[CC_MEM_HISTOGRAM_BUCKETS];
+
+#ifdef CC_MEM_SITES
+static site_t sites[CC_MEM_MAX_SITES];
+#endif
+
+static inline header_t *get_header(void *ptr) {
+    return (header_t *)((unsigned char *)ptr - HEADER_SIZE);
+}
+
+static inline void *get_ptr(header_t *header) {
+    return (unsigned char *)header + HEADER_SIZE;
+}
+
+static inline unsigned size_bucket(size_t size) {
+    unsigned bucket = 0;
+    while(size > 1 && bucket < CC_MEM_HISTOGRAM_BUCKETS - 1) {
+        size >>= 1;
+        bucket += 1;
+    }
+    return bucket;
+}
+
+#ifdef CC_MEM_SITES
+// Sites live in a fixed-size, open-addressed table. File names are string literals, so their
+// addresses are stable and can be hashed directly. Slots are claimed with a CAS and never freed,
+// so lookups don't need a lock. Once the table is full, new sites go unrecorded.
+static uint32_t find_site(const char *file, int line) {
+    if(!file) return NO_SITE;
+    uint64_t hash = ((uintptr_t)file ^ ((uint64_t)line * 0x9e3779b97f4a7c15ULL)) * 0xff51afd7ed558ccdULL;
+    uint32_t mask = CC_MEM_MAX_SITES - 1;
+
+    for(uint32_t i = 0, idx = (hash >> 32) & mask; i < CC_MEM_MAX_SITES; ++i, idx = (idx + 1) & mask) {
+        site_t *site = &sites[idx];
+        int state = atomic_load_explicit(&site->state, memory_order_acquire);
+
+        if(state == SITE_EMPTY) {
+            int expected = SITE_EMPTY;
+            if(atomic_compare_exchange_strong(&site->state, &expected, SITE_CLAIMED)) {
+                site->file = file;
+                site->line = line;
+                atomic_store_explicit(&site->state, SITE_READY, memory_order_release);
+                return idx;
+            }
+            state = expected;
+        }
+        while(state == SITE_CLAIMED) {
+            state = atomic_load_explicit(&site->state, memory_order_acquire);
+        }
+        if(site->file == file && site->line == line) return idx;
+    }
+    return NO_SITE;
+}
+#endif
+
+static void account_alloc(header_t *header, size_t size, const char *file, int line) {
+    header->size = size;
+
+    size_t live = atomic_fetch_add_explicit(&live_bytes, size, memory_order_relaxed) + size;
+    size_t peak = atomic_load_explicit(&peak_bytes, memory_order_relaxed);
+    while(live > peak && !atomic_compare_exchange_weak_explicit(
+        &peak_bytes, &peak, live, memory_order_relaxed, memory_order_relaxed));
+
+    atomic_fetch_add_explicit(&live_blocks, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram[size_bucket(size)], 1, memory_order_relaxed);
+
+#ifdef CC_MEM_SITES
+    header->site = find_site(file, line);
+    if(header->site == NO_SITE) return;
+    site_t *site = &sites[header->site];
+    atomic_fetch_add_explicit(&site->live_bytes, size, memory_order_relaxed);
+    atomic_fetch_add_explicit(&site->live_blocks, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&site->allocs, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&site->total_bytes, size, memory_order_relaxed);
+#else
+    CCUNUSED(file);
+    CCUNUSED(line);
+    header->site = NO_SITE;
+#endif
+}
+
+static void account_free(header_t *header) {
+    atomic_fetch_sub_explicit(&live_bytes, header->size, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&live_blocks, 1, memory_order_relaxed);
+
+#ifdef CC_MEM_SITES
+    if(header->site == NO_SITE) return;
+    site_t *site = &sites[header->site];
+    atomic_fetch_sub_explicit(&site->live_bytes, header->size, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&site->live_blocks, 1, memory_order_relaxed);
+#endif
+}
+
+void *memstats_alloc(size_t size, const char *file, int line) {
+    header_t *header = cc_raw_alloc(HEADER_SIZE + size);
+    atomic_fetch_add_explicit(&allocs, 1, memory_order_relaxed);
+    account_alloc(header, size, file, line);
+    return get_ptr(header);
+}
+
+void *memstats_realloc(void *ptr, size_t size, const char *file, int line) {
+    if(!ptr) return memstats_alloc(size, file, line);
+    if(!size) {
+        memstats_free(ptr);
+        return NULL;
+    }
+
+    header_t *header = get_header(ptr);
+    account_free(header);
+    header = cc_raw_realloc(header, HEADER_SIZE + size);
+    atomic_fetch_add_explicit(&reallocs, 1, memory_order_relaxed);
+    account_alloc(header, size, file, line);
+    return get_ptr(header);
+}
+
+void memstats_free(void *ptr) {
+    if(!ptr) return;
+    header_t *header = get_header(ptr);
+    atomic_fetch_add_explicit(&frees, 1, memory_order_relaxed);
+    account_free(header);
+    cc_raw_free(header);
+}
+
+bool cc_mem_stats(cc_mem_stats_t *out) {
+    CCASSERT(out);
+    out->live_bytes = atomic_load_explicit(&live_bytes, memory_order_relaxed);
+    out->peak_bytes = atomic_load_explicit(&peak_bytes, memory_order_relaxed);
+    out->live_blocks = atomic_load_explicit(&live_blocks, memory_order_relaxed);
+    out->allocs = atomic_load_explicit(&allocs, memory_order_relaxed);
+    out->reallocs = atomic_load_explicit(&reallocs, memory_order_relaxed);
+    out->frees = atomic_load_explicit(&frees, memory_order_relaxed);
+    for(unsigned i = 0; i < CC_MEM_HISTOGRAM_BUCKETS; ++i) {
+        out->histogram[i] = atomic_load_explicit(&histogram[i], memory_order_relaxed);
+    }
+    return true;
+}
+
+#ifdef CC_MEM_SITES
+static int compare_sites(const void *ap, const void *bp) {
+    const cc_mem_site_t *a = ap;
+    const cc_mem_site_t *b = bp;
+    if(a->live_bytes != b->live_bytes) return a->live_bytes < b->live_bytes ? 1 : -1;
+    if(a->allocs != b->allocs) return a->allocs < b->allocs ? 1 : -1;
+    return 0;
+}
+
+size_t cc_mem_sites(cc_mem_site_t *out, size_t max) {
+    CCASSERT(out || !max);
+    cc_mem_site_t *all = cc_raw_alloc(CC_MEM_MAX_SITES * sizeof(cc_mem_site_t));
+    size_t count = 0;
+
+    for(size_t i = 0; i < CC_MEM_MAX_SITES; ++i) {
+        site_t *site = &sites[i];
+        if(atomic_load_explicit(&site->state, memory_order_acquire) != SITE_READY) continue;
+        cc_mem_site_t *entry = &all[count++];
+        entry->file = site->file;
+        entry->line = site->line;
+        entry->live_bytes = atomic_load_explicit(&site->live_bytes, memory_order_relaxed);
+        entry->live_blocks = atomic_load_explicit(&site->live_blocks, memory_order_relaxed);
+        entry->allocs = atomic_load_explicit(&site->allocs, memory_order_relaxed);
+        entry->total_bytes = atomic_load_explicit(&site->total_bytes, memory_order_relaxed);
+    }
+    qsort(all, count, sizeof(cc_mem_site_t), compare_sites);
+
+    if(count > max) count = max;
+    for(size_t i = 0; i < count; ++i) out[i] = all[i];
+    cc_raw_free(all);
+    return count;
+}
+#else
+size_t cc_mem_sites(cc_mem_site_t *out, size_t max) {
+    CCUNUSED(out);
+    CCUNUSED(max);
+    return 0;
+}
+#endif
+
+#else
+
+bool cc_mem_stats(cc_mem_stats_t *out) {
+    CCUNUSED(out);
+    return false;
+}
+
+size_t cc_mem_sites(cc_mem_site_t *out, size_t max) {
+    CCUNUSED(out);
+    CCUNUSED(max);
+    return 0;
+}
+
+#endif
+
+#define DUMP_MAX_SITES (32)
+
+void cc_mem_dump(void) {
+    cc_mem_stats_t stats;
+    if(!cc_mem_stats(&stats)) {
+        cc_printf("memory statistics are disabled (configure with CCORE_MEM_STATS)\n");
+        return;
+    }
+
+    cc_printf("memory: %zu bytes live in %zu blocks, peak %zu bytes\n",
+        stats.live_bytes, stats.live_blocks, stats.peak_bytes);
+    cc_printf("        %llu allocs, %llu reallocs, %llu frees\n",
+        (unsigned long long)stats.allocs,
+        (unsigned long long)stats.reallocs,
+        (unsigned long long)stats.frees);
+
+    cc_printf("size histogram:\n");
+    for(unsigned i = 0; i < CC_MEM_HISTOGRAM_BUCKETS; ++i) {
+        if(!stats.histogram[i]) continue;
+        cc_printf("  %12zu+ B: %llu\n", (size_t)1 << i, (unsigned long long)stats.histogram[i]);
+    }
+
+    cc_mem_site_t sites[DUMP_MAX_SITES];
+    size_t count = cc_mem_sites(sites, DUMP_MAX_SITES);
+    if(!count) return;
+    cc_printf("call sites by live bytes:\n");
+    for(size_t i = 0; i < count; ++i) {
+        cc_printf("  %s:%d: %zu bytes live in %zu blocks, %llu allocs (%llu bytes total)\n",
+            sites[i].file, sites[i].line,
+            sites[i].live_bytes, sites[i].live_blocks,
+            (unsigned long long)sites[i].allocs,
+            (unsigned long long)sites[i].total_bytes);
+    }
+}
@@ -0,0 +1,20 @@
+//===--------------------------------------------------------------------------------------------===
+// memstats - private header for allocation statistics
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <stddef.h>
+
+void *memstats_alloc(size_t size, const char *file, int line);
+void *memstats_realloc(void *ptr, size_t size, const char *file, int line);
+void memstats_free(void *ptr);
+
+/// The allocation layer under the statistics (the thread-local cache, or the backend allocator),
+/// provided by memory.c.
+void *cc_raw_alloc(size_t size);
+void *cc_raw_realloc(void *ptr, size_t size);
+void cc_raw_free(void *ptr);
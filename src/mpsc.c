@@ -0,0 +1,100 @@
+//===--------------------------------------------------------------------------------------------===
+// mpsc.c - Lock-free intrusive multi-producer, single-consumer queue
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/mpsc.h>
+#include <ccore/log.h>
+
+// Producers swap themselves in as the [head] of the queue with a single atomic exchange, then
+// link the previous head to themselves. The consumer walks the [next] links from [tail]. Between
+// the exchange and the link, the chain is briefly cut: the consumer then stops and reports the
+// queue as empty rather than wait for the producer.
+//
+// The queue always holds at least one node, so that producers never have to touch [tail]. The
+// [stub] node embedded in the queue is that node when no object is in it, and is pushed back
+// whenever the consumer is about to take the last object.
+//
+// The header is included from C++, so the links are plain pointers accessed with atomic builtins.
+
+static inline cclist_node_t *get_node(const ccmpsc_t *queue, const void *ptr) {
+    return (cclist_node_t *)((char *)ptr + queue->offset);
+}
+
+static inline void *get_ptr(const ccmpsc_t *queue, cclist_node_t *node) {
+    return (char *)node - queue->offset;
+}
+
+static inline cclist_node_t *load_next(cclist_node_t *node) {
+    return __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+}
+
+static void push_node(ccmpsc_t *queue, cclist_node_t *node) {
+    __atomic_store_n(&node->next, NULL, __ATOMIC_RELAXED);
+    cclist_node_t *prev = __atomic_exchange_n(&queue->head, node, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+}
+
+void ccmpsc_init(ccmpsc_t *queue, size_t offset) {
+    CCASSERT(queue);
+    queue->offset = offset;
+    queue->stub.next = NULL;
+    queue->stub.prev = NULL;
+    queue->tail = &queue->stub;
+    __atomic_store_n(&queue->head, &queue->stub, __ATOMIC_RELEASE);
+}
+
+void ccmpsc_push(ccmpsc_t *queue, void *object) {
+    CCASSERT(queue);
+    CCASSERT(object);
+    push_node(queue, get_node(queue, object));
+}
+
+void *ccmpsc_pop(ccmpsc_t *queue) {
+    CCASSERT(queue);
+    cclist_node_t *tail = queue->tail;
+    cclist_node_t *next = load_next(tail);
+
+    if(tail == &queue->stub) {
+        if(!next) return NULL;
+        queue->tail = next;
+        tail = next;
+        next = load_next(next);
+    }
+    if(next) {
+        queue->tail = next;
+        return get_ptr(queue, tail);
+    }
+
+    // [tail] is the last node linked so far. If it is not the head, a producer is still linking
+    // the node after it; otherwise, the stub goes back in so that [tail] can be handed out.
+    if(tail != __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE)) return NULL;
+    push_node(queue, &queue->stub);
+
+    next = load_next(tail);
+    if(!next) return NULL;
+    queue->tail = next;
+    return get_ptr(queue, tail);
+}
+
+size_t ccmpsc_drain(ccmpsc_t *queue, size_t max, ccmpsc_callback_f fn, void *user_data) {
+    CCASSERT(queue);
+    CCASSERT(fn);
+    size_t count = 0;
+    while(count < max) {
+        void *object = ccmpsc_pop(queue);
+        if(!object) break;
+        fn(object, user_data);
+        count += 1;
+    }
+    return count;
+}
+
+bool ccmpsc_is_empty(const ccmpsc_t *queue) {
+    CCASSERT(queue);
+    const cclist_node_t *tail = queue->tail;
+    return tail == &queue->stub && !__atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,28 @@
+//===--------------------------------------------------------------------------------------------===
+// phash - private header for the perfect hash used by frozen tables and snapshots
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <ccore/hash.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// A key with [hash] belongs to bucket phash_bucket(), and lives in slot phash_slot() where
+// [pilot] is the pilot of its bucket. Snapshots store the pilots and seed on disk, so changing
+// either function requires a new snapshot version.
+
+// The average number of keys per bucket: tables of [size] keys have
+// size / PHASH_KEYS_PER_BUCKET + 1 buckets.
+#define PHASH_KEYS_PER_BUCKET (4)
+
+static inline size_t phash_bucket(uint64_t hash, size_t bucket_count) {
+    return hash % bucket_count;
+}
+
+static inline size_t phash_slot(uint64_t hash, uint64_t seed, uint32_t pilot, size_t size) {
+    return cc_hash_u64(hash ^ (seed + pilot * 0x9e3779b97f4a7c15ull)) % size;
+}
@@ -0,0 +1,174 @@
+//===--------------------------------------------------------------------------------------------===
+// ring.c - Contiguous growable ring buffer/double-ended queue
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/ring.h>
+#include <ccore/log.h>
+#include <string.h>
+
+#define RING_MIN_CAPACITY (8)
+
+static inline size_t ring_index(const ccring_t *ring, size_t index) {
+    return (ring->head + index) & (ring->capacity - 1);
+}
+
+static inline unsigned char *slot(const ccring_t *ring, size_t i) {
+    return ring->data + i * ring->elem_size;
+}
+
+static size_t next_pow2(size_t n) {
+    size_t p = RING_MIN_CAPACITY;
+    while(p < n) p <<= 1;
+    return p;
+}
+
+// Growing keeps the elements at the same indices: the buffer is reallocated, and if the elements
+// wrapped around, the part at the start of the buffer is moved after the old end.
+static void ring_grow(ccring_t *ring, size_t capacity) {
+    capacity = next_pow2(capacity);
+    if(capacity <= ring->capacity) return;
+
+    size_t old_capacity = ring->capacity;
+    ring->data = cc_realloc_with(
+        ring->allocator,
+        ring->data,
+        old_capacity * ring->elem_size,
+        capacity * ring->elem_size
+    );
+    ring->capacity = capacity;
+
+    if(ring->head + ring->count > old_capacity) {
+        size_t wrapped = ring->head + ring->count - old_capacity;
+        memcpy(slot(ring, old_capacity), slot(ring, 0), wrapped * ring->elem_size);
+    }
+}
+
+// Copies [count] elements between [ring] starting at [index] and the flat buffer [buffer], in at
+// most two contiguous runs.
+static void ring_copy_out(const ccring_t *ring, size_t index, void *buffer, size_t count) {
+    size_t start = ring_index(ring, index);
+    size_t first = ring->capacity - start;
+    if(first > count) first = count;
+
+    unsigned char *out = buffer;
+    memcpy(out, slot(ring, start), first * ring->elem_size);
+    memcpy(out + first * ring->elem_size, slot(ring, 0), (count - first) * ring->elem_size);
+}
+
+static void ring_copy_in(ccring_t *ring, size_t index, const void *buffer, size_t count) {
+    size_t start = ring_index(ring, index);
+    size_t first = ring->capacity - start;
+    if(first > count) first = count;
+
+    const unsigned char *in = buffer;
+    memcpy(slot(ring, start), in, first * ring->elem_size);
+    memcpy(slot(ring, 0), in + first * ring->elem_size, (count - first) * ring->elem_size);
+}
+
+void ccring_init(ccring_t *ring, size_t elem_size) {
+    ccring_init_with(ring, elem_size, NULL);
+}
+
+void ccring_init_with(ccring_t *ring, size_t elem_size, const cc_allocator_t *allocator) {
+    CCASSERT(ring);
+    CCASSERT(elem_size);
+    ring->data = NULL;
+    ring->elem_size = elem_size;
+    ring->capacity = 0;
+    ring->head = 0;
+    ring->count = 0;
+    ring->allocator = allocator;
+}
+
+void ccring_deinit(ccring_t *ring) {
+    CCASSERT(ring);
+    if(ring->data) cc_free_with(ring->allocator, ring->data, ring->capacity * ring->elem_size);
+    ccring_init_with(ring, ring->elem_size, ring->allocator);
+}
+
+void ccring_clear(ccring_t *ring) {
+    CCASSERT(ring);
+    ring->head = 0;
+    ring->count = 0;
+}
+
+void ccring_reserve(ccring_t *ring, size_t capacity) {
+    CCASSERT(ring);
+    ring_grow(ring, capacity);
+}
+
+void ccring_push_back(ccring_t *ring, const void *elem) {
+    CCASSERT(ring);
+    CCASSERT(elem);
+    if(ring->count == ring->capacity) ring_grow(ring, ring->capacity + 1);
+    memcpy(ccring_at(ring, ring->count), elem, ring->elem_size);
+    ring->count += 1;
+}
+
+void ccring_push_front(ccring_t *ring, const void *elem) {
+    CCASSERT(ring);
+    CCASSERT(elem);
+    if(ring->count == ring->capacity) ring_grow(ring, ring->capacity + 1);
+    ring->head = (ring->head - 1) & (ring->capacity - 1);
+    memcpy(slot(ring, ring->head), elem, ring->elem_size);
+    ring->count += 1;
+}
+
+void ccring_push_back_overwrite(ccring_t *ring, const void *elem) {
+    CCASSERT(ring);
+    CCASSERT(elem);
+    if(ring->capacity && ring->count == ring->capacity) {
+        ring->head = ring_index(ring, 1);
+        ring->count -= 1;
+    }
+    ccring_push_back(ring, elem);
+}
+
+bool ccring_pop_front(ccring_t *ring, void *out) {
+    CCASSERT(ring);
+    if(!ring->count) return false;
+    if(out) memcpy(out, slot(ring, ring->head), ring->elem_size);
+    ring->head = ring_index(ring, 1);
+    ring->count -= 1;
+    return true;
+}
+
+bool ccring_pop_back(ccring_t *ring, void *out) {
+    CCASSERT(ring);
+    if(!ring->count) return false;
+    ring->count -= 1;
+    if(out) memcpy(out, ccring_at(ring, ring->count), ring->elem_size);
+    return true;
+}
+
+void ccring_write(ccring_t *ring, const void *elems, size_t count) {
+    CCASSERT(ring);
+    if(!count) return;
+    CCASSERT(elems);
+    if(ring->count + count > ring->capacity) ring_grow(ring, ring->count + count);
+    ring_copy_in(ring, ring->count, elems, count);
+    ring->count += count;
+}
+
+size_t ccring_read(ccring_t *ring, void *out, size_t count) {
+    CCASSERT(ring);
+    if(count > ring->count) count = ring->count;
+    if(!count) return 0;
+    if(out) ring_copy_out(ring, 0, out, count);
+    ring->head = ring_index(ring, count);
+    ring->count -= count;
+    return count;
+}
+
+size_t ccring_copy(const ccring_t *ring, size_t index, void *out, size_t count) {
+    CCASSERT(ring);
+    CCASSERT(out);
+    if(index >= ring->count) return 0;
+    if(count > ring->count - index) count = ring->count - index;
+    ring_copy_out(ring, index, out, count);
+    return count;
+}
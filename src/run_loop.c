@@ -34,6 +34,7 @@ struct cc_run_loop_t {
     char name[20];
     
     rl_entry_t programs;
+    cc_pool_t entry_pool;
 
     pthread_t thread;
     pthread_mutex_t loops_mt;
@@ -114,6 +115,7 @@ cc_run_loop_t *cc_run_loop_new(const char *name) {
     
     loop->programs.next = &loop->programs;
     loop->programs.prev = &loop->programs;
+    cc_pool_init(&loop->entry_pool, sizeof(rl_entry_t));
 
     pthread_mutex_lock(&loop->mt);
     pthread_create(&loop->thread, NULL, &loop_thread, loop);
@@ -132,12 +134,7 @@ void cc_run_loop_delete(cc_run_loop_t *rl) {
     pthread_mutex_unlock(&rl->mt);
     pthread_join(rl->thread, NULL);
     
-    rl_entry_t *rl_entry = rl->programs.next;
-    while(rl_entry != &rl->programs) {
-        rl_entry_t *to_del = rl_entry;
-        rl_entry = rl_entry->next;
-        cc_free(to_del);
-    }
+    cc_pool_deinit(&rl->entry_pool);
     
     pthread_cond_destroy(&rl->cv);
     pthread_mutex_destroy(&rl->mt);
@@ -157,13 +154,13 @@ cc_run_loop_handle_t cc_run_loop_register(
     CCASSERT(ticker);
     CCASSERT(freq > 0);
     
-    rl_entry_t *entry = cc_alloc(sizeof(rl_entry_t));
+    pthread_mutex_lock(&rl->loops_mt);
+    rl_entry_t *entry = CC_POOL_NEW(&rl->entry_pool, rl_entry_t);
     entry->main = ticker;
     entry->interval = 1e6 / freq;
     entry->acc = rand() % entry->interval;
     entry->data = data;
     
-    pthread_mutex_lock(&rl->loops_mt);
     entry->prev = rl->programs.prev; // Tail of the DL list
     entry->next = &rl->programs;
 
@@ -187,8 +184,7 @@ void cc_run_loop_unregister(cc_run_loop_t *rl, cc_run_loop_handle_t handle) {
     entry->prev->next = entry->next;
     entry->next->prev = entry->prev;
     entry->prev = entry->next = NULL;
+    cc_pool_free(&rl->entry_pool, entry);
     pthread_mutex_unlock(&rl->loops_mt);
     CCDEBUG("exec %p removed to run_loop `%s`", entry, rl->name);
-    
-    cc_free(entry);
 }
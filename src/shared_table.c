@@ -0,0 +1,327 @@
+//===--------------------------------------------------------------------------------------------===
+// shared_table.c - Concurrent string-indexed hash table
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/shared_table.h>
+#include <ccore/hash.h>
+#include <ccore/log.h>
+#include "epoch.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#define DEFAULT_SHARDS (64)
+#define MIN_CAPACITY (16)
+#define NOT_FOUND (SIZE_MAX)
+
+// Unlinked memory is freed in batches, so that the epoch is not checked on every removal. While a
+// stalled reader keeps the epoch from moving, the batch size doubles on each attempt that frees
+// nothing, so that removals don't keep walking the limbo list.
+#define RECLAIM_THRESHOLD (64)
+
+// Memory that lookups may still be reading, waiting to be freed.
+typedef struct retired_s {
+    struct retired_s *next;
+    uint64_t epoch;
+} retired_t;
+
+// Nodes are never modified once published, so lookups can read them without synchronisation.
+// Replacing a node is the only way to change a slot.
+typedef struct node_s {
+    retired_t retired;
+    uint64_t hash;
+    size_t length;
+    void *value;
+    char key[];
+} node_t;
+
+// Each shard is a linear-probing table of node pointers. Removed nodes are replaced with
+// TOMBSTONE, so that the probe sequences of other keys stay intact.
+typedef struct slots_s {
+    retired_t retired;
+    size_t capacity;
+    _Atomic(node_t *) nodes[];
+} slots_t;
+
+typedef struct ccshared_shard_s {
+    _Alignas(CC_CACHE_LINE_SIZE) pthread_mutex_t lock;
+    _Atomic(slots_t *) slots;
+    atomic_size_t size;
+    size_t used;
+    retired_t *limbo;
+    size_t limbo_count;
+    size_t reclaim_at;
+} shard_t;
+
+static node_t tombstone;
+#define TOMBSTONE (&tombstone)
+
+static inline size_t next_power_of_2(size_t v) {
+    v -= 1;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+#if SIZE_MAX > UINT32_MAX
+    v |= v >> 32;
+#endif
+    v += 1;
+    return v;
+}
+
+// Shards are kept at most 3/4 full, counting tombstones.
+static inline size_t max_load(size_t capacity) {
+    return capacity - capacity / 4;
+}
+
+static inline size_t capacity_for(size_t count) {
+    size_t capacity = next_power_of_2(count + count / 3 + 1);
+    return capacity < MIN_CAPACITY ? MIN_CAPACITY : capacity;
+}
+
+// The low bits of a hash pick a slot in a shard, so the shard is picked with higher bits.
+static inline shard_t *shard_for(const ccshared_table_t *table, uint64_t hash) {
+    return &table->shards[(hash >> 32) & (table->shard_count - 1)];
+}
+
+static slots_t *slots_new(size_t capacity) {
+    slots_t *slots = cc_alloc(sizeof(slots_t) + capacity * sizeof(_Atomic(node_t *)));
+    slots->capacity = capacity;
+    for(size_t i = 0; i < capacity; ++i) atomic_init(&slots->nodes[i], NULL);
+    return slots;
+}
+
+// Returns the slot holding the node for [key] and stores the node in [found], or returns
+// NOT_FOUND. Shards always have empty slots, so probing stops.
+static size_t slots_find(
+    const slots_t *slots,
+    uint64_t hash,
+    const char *key,
+    size_t length,
+    node_t **found
+) {
+    size_t mask = slots->capacity - 1;
+    for(size_t i = hash & mask;; i = (i + 1) & mask) {
+        node_t *node = atomic_load_explicit(&slots->nodes[i], memory_order_acquire);
+        if(!node) return NOT_FOUND;
+        if(node == TOMBSTONE || node->hash != hash || node->length != length) continue;
+        if(memcmp(node->key, key, length)) continue;
+        if(found) *found = node;
+        return i;
+    }
+}
+
+// Returns the first empty or removed slot in the probe sequence of [hash].
+static size_t slots_find_free(const slots_t *slots, uint64_t hash) {
+    size_t mask = slots->capacity - 1;
+    for(size_t i = hash & mask;; i = (i + 1) & mask) {
+        node_t *node = atomic_load_explicit(&slots->nodes[i], memory_order_relaxed);
+        if(!node || node == TOMBSTONE) return i;
+    }
+}
+
+// MARK: - Reclamation
+
+static void reclaim(shard_t *shard) {
+    // The limbo list is newest first, so everything from the first safe entry on is safe too.
+    uint64_t current = epoch_advance();
+    retired_t **link = &shard->limbo;
+    while(*link && (*link)->epoch + 2 > current) link = &(*link)->next;
+
+    retired_t *retired = *link;
+    *link = NULL;
+    if(!retired) {
+        shard->reclaim_at *= 2;
+        return;
+    }
+    while(retired) {
+        retired_t *next = retired->next;
+        cc_free(retired);
+        shard->limbo_count -= 1;
+        retired = next;
+    }
+    shard->reclaim_at = shard->limbo_count + RECLAIM_THRESHOLD;
+}
+
+// Frees [retired] once no lookup can be reading it. Called with the shard locked, after
+// [retired] was unlinked.
+static void retire(shard_t *shard, retired_t *retired) {
+    retired->epoch = epoch_current();
+    retired->next = shard->limbo;
+    shard->limbo = retired;
+    if(++shard->limbo_count >= shard->reclaim_at) reclaim(shard);
+}
+
+// MARK: - Shards
+
+// Moves the nodes of [shard] to new slots with room for twice its keys, dropping tombstones.
+// Lookups that started before the new slots are published keep using the old ones.
+static void shard_rebuild(shard_t *shard) {
+    slots_t *old = atomic_load_explicit(&shard->slots, memory_order_relaxed);
+    size_t size = atomic_load_explicit(&shard->size, memory_order_relaxed);
+    slots_t *slots = slots_new(capacity_for(size * 2));
+
+    for(size_t i = 0; i < old->capacity; ++i) {
+        node_t *node = atomic_load_explicit(&old->nodes[i], memory_order_relaxed);
+        if(!node || node == TOMBSTONE) continue;
+        size_t slot = slots_find_free(slots, node->hash);
+        atomic_store_explicit(&slots->nodes[slot], node, memory_order_relaxed);
+    }
+    shard->used = size;
+    atomic_store_explicit(&shard->slots, slots, memory_order_release);
+    retire(shard, &old->retired);
+}
+
+static void shard_init(shard_t *shard, size_t count) {
+    pthread_mutex_init(&shard->lock, NULL);
+    atomic_init(&shard->slots, slots_new(capacity_for(count)));
+    atomic_init(&shard->size, 0);
+    shard->used = 0;
+    shard->limbo = NULL;
+    shard->limbo_count = 0;
+    shard->reclaim_at = RECLAIM_THRESHOLD;
+}
+
+static void shard_deinit(shard_t *shard, cc_destructor des, void *user_data) {
+    slots_t *slots = atomic_load_explicit(&shard->slots, memory_order_relaxed);
+    for(size_t i = 0; i < slots->capacity; ++i) {
+        node_t *node = atomic_load_explicit(&slots->nodes[i], memory_order_relaxed);
+        if(!node || node == TOMBSTONE) continue;
+        if(des) des(node->value, user_data);
+        cc_free(node);
+    }
+    cc_free(slots);
+
+    while(shard->limbo) {
+        retired_t *next = shard->limbo->next;
+        cc_free(shard->limbo);
+        shard->limbo = next;
+    }
+    pthread_mutex_destroy(&shard->lock);
+}
+
+// MARK: - Public API
+
+void ccshared_table_init(ccshared_table_t *table, size_t count, size_t shards) {
+    CCASSERT(table);
+    table->shard_count = next_power_of_2(shards ? shards : DEFAULT_SHARDS);
+    table->shards = cc_alloc_aligned(table->shard_count * sizeof(shard_t), CC_CACHE_LINE_SIZE);
+
+    size_t per_shard = count / table->shard_count + 1;
+    for(size_t i = 0; i < table->shard_count; ++i) {
+        shard_init(&table->shards[i], per_shard);
+    }
+}
+
+void ccshared_table_deinit(ccshared_table_t *table, cc_destructor des, void *user_data) {
+    CCASSERT(table);
+    for(size_t i = 0; i < table->shard_count; ++i) {
+        shard_deinit(&table->shards[i], des, user_data);
+    }
+    cc_free_aligned(table->shards);
+    table->shards = NULL;
+    table->shard_count = 0;
+}
+
+size_t ccshared_table_size(const ccshared_table_t *table) {
+    CCASSERT(table);
+    size_t size = 0;
+    for(size_t i = 0; i < table->shard_count; ++i) {
+        size += atomic_load_explicit(&table->shards[i].size, memory_order_relaxed);
+    }
+    return size;
+}
+
+bool ccshared_table_insert(ccshared_table_t *table, const char *key, void *value) {
+    CCASSERT(key);
+    return ccshared_table_insert_n(table, key, strlen(key), value);
+}
+
+bool ccshared_table_insert_n(ccshared_table_t *table, const char *key, size_t length, void *value) {
+    CCASSERT(table);
+    CCASSERT(key);
+    uint64_t hash = cc_hash_bytes(key, length, 0);
+    shard_t *shard = shard_for(table, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    slots_t *slots = atomic_load_explicit(&shard->slots, memory_order_relaxed);
+    if(slots_find(slots, hash, key, length, NULL) != NOT_FOUND) {
+        pthread_mutex_unlock(&shard->lock);
+        return false;
+    }
+    if(shard->used + 1 > max_load(slots->capacity)) {
+        shard_rebuild(shard);
+        slots = atomic_load_explicit(&shard->slots, memory_order_relaxed);
+    }
+
+    node_t *node = cc_alloc(sizeof(node_t) + length + 1);
+    node->hash = hash;
+    node->length = length;
+    node->value = value;
+    memcpy(node->key, key, length);
+    node->key[length] = '\0';
+
+    size_t slot = slots_find_free(slots, hash);
+    if(!atomic_load_explicit(&slots->nodes[slot], memory_order_relaxed)) shard->used += 1;
+    atomic_store_explicit(&slots->nodes[slot], node, memory_order_release);
+    atomic_fetch_add_explicit(&shard->size, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&shard->lock);
+    return true;
+}
+
+void *ccshared_table_get(const ccshared_table_t *table, const char *key) {
+    CCASSERT(key);
+    return ccshared_table_get_n(table, key, strlen(key));
+}
+
+void *ccshared_table_get_n(const ccshared_table_t *table, const char *key, size_t length) {
+    CCASSERT(table);
+    CCASSERT(key);
+    uint64_t hash = cc_hash_bytes(key, length, 0);
+    shard_t *shard = shard_for(table, hash);
+
+    node_t *node = NULL;
+    epoch_enter();
+    slots_t *slots = atomic_load_explicit(&shard->slots, memory_order_acquire);
+    void *value = slots_find(slots, hash, key, length, &node) != NOT_FOUND ? node->value : NULL;
+    epoch_exit();
+    return value;
+}
+
+bool ccshared_table_remove(ccshared_table_t *table, const char *key, void **value) {
+    CCASSERT(key);
+    return ccshared_table_remove_n(table, key, strlen(key), value);
+}
+
+bool ccshared_table_remove_n(
+    ccshared_table_t *table,
+    const char *key,
+    size_t length,
+    void **value
+) {
+    CCASSERT(table);
+    CCASSERT(key);
+    uint64_t hash = cc_hash_bytes(key, length, 0);
+    shard_t *shard = shard_for(table, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    slots_t *slots = atomic_load_explicit(&shard->slots, memory_order_relaxed);
+    node_t *node = NULL;
+    size_t slot = slots_find(slots, hash, key, length, &node);
+    if(slot == NOT_FOUND) {
+        pthread_mutex_unlock(&shard->lock);
+        return false;
+    }
+
+    atomic_store_explicit(&slots->nodes[slot], TOMBSTONE, memory_order_release);
+    atomic_fetch_sub_explicit(&shard->size, 1, memory_order_relaxed);
+    if(value) *value = node->value;
+    retire(shard, &node->retired);
+    pthread_mutex_unlock(&shard->lock);
+    return true;
+}
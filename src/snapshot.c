@@ -0,0 +1,330 @@
+//===--------------------------------------------------------------------------------------------===
+// snapshot.c - Memory-mapped, read-only table snapshots
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include <ccore/snapshot.h>
+#include <ccore/filesystem.h>
+#include <ccore/frozen.h>
+#include <ccore/log.h>
+#include <ccore/memory.h>
+#include "phash.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#if WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// A snapshot file is laid out as:
+//
+//  [header]
+//  [pilots]   bucket_count uint32_t, padded to 8 bytes
+//  [entries]  size snapshot_entry_t, in slot order
+//  [data]     keys (NUL-terminated) and values (8-byte aligned), referenced by entries
+//
+// Every offset is from the start of the file.
+
+#define SNAPSHOT_MAGIC "ccsnap\0\0"
+#define SNAPSHOT_BYTE_ORDER (0x01020304u)
+#define SNAPSHOT_ALIGN (8)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t file_size;
+    uint64_t size;
+    uint64_t bucket_count;
+    uint64_t seed;
+    uint64_t pilots_offset;
+    uint64_t entries_offset;
+} snapshot_header_t;
+
+typedef struct {
+    uint64_t key_offset;
+    uint64_t value_offset;
+    uint64_t value_size;
+    uint32_t key_length;
+    uint32_t reserved;
+} snapshot_entry_t;
+
+static inline uint64_t align_up(uint64_t offset) {
+    return (offset + SNAPSHOT_ALIGN - 1) & ~(uint64_t)(SNAPSHOT_ALIGN - 1);
+}
+
+static inline const snapshot_header_t *get_header(const ccsnapshot_t *snapshot) {
+    return (const snapshot_header_t *)snapshot->data;
+}
+
+// MARK: - Writing
+
+typedef struct {
+    const void *data;
+    size_t size;
+} value_bytes_t;
+
+static bool write_padding(FILE *file, uint64_t *offset) {
+    static const char zeros[SNAPSHOT_ALIGN] = {0};
+    size_t padding = align_up(*offset) - *offset;
+    *offset += padding;
+    return fwrite(zeros, 1, padding, file) == padding;
+}
+
+static bool write_bytes(FILE *file, const void *data, size_t size, uint64_t *offset) {
+    *offset += size;
+    return fwrite(data, 1, size, file) == size;
+}
+
+static bool write_snapshot(
+    FILE *file,
+    const ccfrozen_table_t *frozen,
+    const value_bytes_t *values
+) {
+    snapshot_header_t header = {
+        .magic = SNAPSHOT_MAGIC,
+        .version = CCSNAPSHOT_VERSION,
+        .byte_order = SNAPSHOT_BYTE_ORDER,
+        .size = frozen->size,
+        .bucket_count = frozen->bucket_count,
+        .seed = frozen->seed,
+    };
+    header.pilots_offset = align_up(sizeof(header));
+    uint64_t pilots_size = frozen->bucket_count * sizeof(uint32_t);
+    header.entries_offset = align_up(header.pilots_offset + pilots_size);
+
+    // Keys first, then values, each of them aligned.
+    uint64_t data_offset = header.entries_offset + frozen->size * sizeof(snapshot_entry_t);
+    uint64_t offset = data_offset;
+    for(size_t i = 0; i < frozen->size; ++i) offset += frozen->entries[i].length + 1;
+    for(size_t i = 0; i < frozen->size; ++i) offset = align_up(offset) + values[i].size;
+    header.file_size = offset;
+
+    offset = 0;
+    bool ok = write_bytes(file, &header, sizeof(header), &offset)
+        && write_padding(file, &offset)
+        && write_bytes(file, frozen->pilots, pilots_size, &offset)
+        && write_padding(file, &offset);
+
+    uint64_t key_offset = data_offset;
+    uint64_t value_offset = data_offset;
+    for(size_t i = 0; i < frozen->size; ++i) value_offset += frozen->entries[i].length + 1;
+    for(size_t i = 0; ok && i < frozen->size; ++i) {
+        value_offset = align_up(value_offset);
+        snapshot_entry_t entry = {
+            .key_offset = key_offset,
+            .value_offset = value_offset,
+            .value_size = values[i].size,
+            .key_length = frozen->entries[i].length,
+            .reserved = 0,
+        };
+        ok = write_bytes(file, &entry, sizeof(entry), &offset);
+        key_offset += entry.key_length + 1;
+        value_offset += entry.value_size;
+    }
+
+    for(size_t i = 0; ok && i < frozen->size; ++i) {
+        const ccfrozen_entry_t *entry = &frozen->entries[i];
+        ok = write_bytes(file, ccfrozen_key(frozen, entry), entry->length + 1, &offset);
+    }
+    for(size_t i = 0; ok && i < frozen->size; ++i) {
+        ok = write_padding(file, &offset)
+            && write_bytes(file, values[i].data, values[i].size, &offset);
+    }
+    CCASSERT(!ok || offset == header.file_size);
+    return ok;
+}
+
+// rename() does not replace an existing file on Windows.
+static bool replace_file(const char *from, const char *to) {
+#if WIN32
+    if(MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING)) return true;
+    CCERROR("cannot replace `%s` (error %lu)", to, (unsigned long)GetLastError());
+#else
+    if(!rename(from, to)) return true;
+    CCERROR("cannot replace `%s`: %s", to, strerror(errno));
+#endif
+    return false;
+}
+
+bool cctable_write_snapshot(
+    const cctable_t *table,
+    const char *path,
+    ccsnapshot_value_f value_bytes,
+    void *user_data
+) {
+    CCASSERT(table);
+    CCASSERT(path);
+
+    ccfrozen_table_t frozen;
+    if(!cctable_freeze(table, &frozen)) return false;
+
+    value_bytes_t *values = cc_alloc(frozen.size * sizeof(value_bytes_t) + 1);
+    uint64_t *integers = cc_alloc(frozen.size * sizeof(uint64_t) + 1);
+    for(size_t i = 0; i < frozen.size; ++i) {
+        void *value = frozen.entries[i].value;
+        if(value_bytes) {
+            values[i].data = value_bytes(value, &values[i].size, user_data);
+        } else {
+            integers[i] = (uint64_t)(uintptr_t)value;
+            values[i] = (value_bytes_t){&integers[i], sizeof(uint64_t)};
+        }
+    }
+
+    size_t temp_size = strlen(path) + sizeof(".tmp");
+    char *temp_path = cc_alloc(temp_size);
+    snprintf(temp_path, temp_size, "%s.tmp", path);
+    FILE *file = ccfs_file_open(temp_path, CCFS_WRITE);
+    bool ok = file != NULL;
+    if(file) {
+        ok = write_snapshot(file, &frozen, values);
+        ok = !fclose(file) && ok;
+        ok = ok && replace_file(temp_path, path);
+        if(!ok) remove(temp_path);
+    }
+    cc_free(temp_path);
+
+    cc_free(integers);
+    cc_free(values);
+    ccfrozen_deinit(&frozen);
+    return ok;
+}
+
+// MARK: - Reading
+
+static bool map_file(ccsnapshot_t *snapshot, const char *path) {
+#if WIN32
+    HANDLE file = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if(GetFileSizeEx(file, &size) && size.QuadPart) {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    CloseHandle(file);
+    if(!mapping) return false;
+
+    snapshot->data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    snapshot->data_size = size.QuadPart;
+    CloseHandle(mapping);
+    return snapshot->data != NULL;
+#else
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return false;
+    struct stat info;
+    void *data = MAP_FAILED;
+    if(!fstat(fd, &info) && info.st_size > 0) {
+        data = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if(data == MAP_FAILED) return false;
+
+    snapshot->data = data;
+    snapshot->data_size = info.st_size;
+    return true;
+#endif
+}
+
+static void unmap_file(ccsnapshot_t *snapshot) {
+#if WIN32
+    UnmapViewOfFile(snapshot->data);
+#else
+    munmap((void *)snapshot->data, snapshot->data_size);
+#endif
+    snapshot->data = NULL;
+    snapshot->data_size = 0;
+}
+
+// Only the header is checked, so opening a snapshot does not touch the rest of the file. Lookups
+// check the offsets they follow instead.
+static bool header_is_valid(const ccsnapshot_t *snapshot) {
+    if(snapshot->data_size < sizeof(snapshot_header_t)) return false;
+    const snapshot_header_t *header = get_header(snapshot);
+    if(memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic))) return false;
+    if(header->version != CCSNAPSHOT_VERSION) return false;
+    if(header->byte_order != SNAPSHOT_BYTE_ORDER) return false;
+    if(header->file_size != snapshot->data_size || !header->bucket_count) return false;
+    if(header->size && header->bucket_count < header->size / PHASH_KEYS_PER_BUCKET + 1) {
+        return false;
+    }
+
+    // Counts are bounded by the space left in the file before they are multiplied, so that a
+    // crafted header cannot wrap the end of a section back inside the file.
+    uint64_t file_size = header->file_size;
+    if(header->pilots_offset > file_size || header->entries_offset > file_size) return false;
+    if(header->bucket_count > (file_size - header->pilots_offset) / sizeof(uint32_t)) return false;
+    if(header->size > (file_size - header->entries_offset) / sizeof(snapshot_entry_t)) return false;
+
+    uint64_t pilots_end = header->pilots_offset + header->bucket_count * sizeof(uint32_t);
+    return header->pilots_offset % SNAPSHOT_ALIGN == 0
+        && header->entries_offset % SNAPSHOT_ALIGN == 0
+        && pilots_end <= header->entries_offset;
+}
+
+bool ccsnapshot_open(ccsnapshot_t *snapshot, const char *path) {
+    CCASSERT(snapshot);
+    CCASSERT(path);
+    if(!map_file(snapshot, path)) {
+        CCERROR("cannot map snapshot `%s`", path);
+        return false;
+    }
+    if(!header_is_valid(snapshot)) {
+        CCERROR("`%s` is not a valid snapshot (version %d)", path, CCSNAPSHOT_VERSION);
+        unmap_file(snapshot);
+        return false;
+    }
+    return true;
+}
+
+void ccsnapshot_close(ccsnapshot_t *snapshot) {
+    CCASSERT(snapshot);
+    if(snapshot->data) unmap_file(snapshot);
+}
+
+size_t ccsnapshot_size(const ccsnapshot_t *snapshot) {
+    CCASSERT(snapshot);
+    return get_header(snapshot)->size;
+}
+
+const void *ccsnapshot_get(const ccsnapshot_t *snapshot, const char *key, size_t *size) {
+    CCASSERT(key);
+    return ccsnapshot_get_n(snapshot, key, strlen(key), size);
+}
+
+const void *ccsnapshot_get_n(
+    const ccsnapshot_t *snapshot,
+    const char *key,
+    size_t length,
+    size_t *size
+) {
+    CCASSERT(snapshot);
+    CCASSERT(key);
+    const snapshot_header_t *header = get_header(snapshot);
+    if(!header->size) return NULL;
+
+    uint64_t hash = cc_hash_bytes(key, length, 0);
+    const uint32_t *pilots = (const uint32_t *)(snapshot->data + header->pilots_offset);
+    uint32_t pilot = pilots[phash_bucket(hash, header->bucket_count)];
+    size_t slot = phash_slot(hash, header->seed, pilot, header->size);
+
+    const unsigned char *entries = snapshot->data + header->entries_offset;
+    const snapshot_entry_t *entry = (const snapshot_entry_t *)entries + slot;
+    if(entry->key_length != length || length > header->file_size) return NULL;
+    if(entry->key_offset > header->file_size - length) return NULL;
+    if(memcmp(snapshot->data + entry->key_offset, key, length)) return NULL;
+    if(entry->value_offset > header->file_size
+       || entry->value_size > header->file_size - entry->value_offset) return NULL;
+
+    if(size) *size = entry->value_size;
+    return snapshot->data + entry->value_offset;
+}
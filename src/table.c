@@ -7,192 +7,713 @@
 // =^•.•^=
 //===--------------------------------------------------------------------------------------------===
 #include <ccore/table.h>
+#include <ccore/hash.h>
 #include <ccore/log.h>
 #include <ccore/memory.h>
+#include <ccore/tpool.h>
+#include "index.h"
+#include <pthread.h>
 #include <string.h>
 
-static inline size_t next_power_of_2(size_t v) {
-    v -= 1;
-    v |= v >> 1;
-    v |= v >> 2;
-    v |= v >> 4;
-    v |= v >> 8;
-    v |= v >> 16;
-    v += 1;
-    return v;
+// A key being looked up, with its length and hash computed once.
+typedef struct {
+    const char *data;
+    size_t length;
+    size_t hash;
+} table_key_t;
+
+static inline table_key_t make_key(const char *key, size_t length) {
+    CCASSERT(key);
+    return (table_key_t){key, length, cc_hash_bytes(key, length, 0)};
 }
 
-static size_t hash_string(const char *string) {
-    CCASSERT(string);
-    //Fowler-Noll-Vo 1a hash
-    // http://www.isthe.com/chongo/src/fnv/hash_64.c
-    // http://create.stephan-brumme.com/fnv-hash/
-    size_t hash = 0x84222325cbf29ce4ULL;
-    for(size_t i = 0; string[i] != '\0'; ++i) {
-        hash = (hash ^ string[i]) * 0x100000001b3ULL;
-    }
-    return hash;
+// Entries keep the full hash and length of their key, so nearly all mismatches that get past the
+// control byte are rejected without reading the key itself.
+static inline bool key_equals(const void *ptr, const void *key_ptr) {
+    const cctable_entry_t *entry = ptr;
+    const table_key_t *key = key_ptr;
+    return entry->hash == key->hash
+        && entry->length == key->length
+        && !memcmp(entry->key, key->data, key->length);
 }
 
-void cctable_init(cctable_t *table, size_t count, bool allow_multiple) {
-    CCASSERT(table);
-    table->size = 0;
-    table->capacity = next_power_of_2(count);
-    table->buckets = cc_alloc(table->capacity * sizeof(cctable_t));
-    table->allow_multiple = allow_multiple;
+// Pool [n] holds keys of up to n * CCTABLE_KEY_CLASS_SIZE characters. Returns
+// CCTABLE_KEY_CLASSES for keys too large to be pooled.
+static inline size_t key_class(size_t key_length) {
+    size_t cls = (key_length + CCTABLE_KEY_CLASS_SIZE - 1) / CCTABLE_KEY_CLASS_SIZE;
+    return cls < CCTABLE_KEY_CLASSES ? cls : CCTABLE_KEY_CLASSES;
+}
+
+static char *key_new(cctable_t *table, const char *key, size_t key_length) {
+    size_t cls = key_class(key_length);
+    char *copy = cls < CCTABLE_KEY_CLASSES
+        ? cc_pool_alloc(&table->key_pools[cls])
+        : cc_alloc_with(table->allocator, key_length + 1);
+    memcpy(copy, key, key_length);
+    copy[key_length] = 0;
+    return copy;
+}
 
-    for(size_t i = 0; i < table->capacity; ++i) {
-        cclist_init(&table->buckets[i], offsetof(ccbucket_node_t, list_node));
+static void key_delete(cctable_t *table, char *key, size_t key_length) {
+    size_t cls = key_class(key_length);
+    if(cls < CCTABLE_KEY_CLASSES) {
+        cc_pool_free(&table->key_pools[cls], key);
+    } else {
+        cc_free_with(table->allocator, key, key_length + 1);
     }
 }
 
-struct destructor_data {
-    cc_destructor destructor;
-    void *user_data;
-};
+// MARK: - Multiple values
+
+// In multi-valued tables, each entry points to a span holding all of its values, so adding a
+// value only allocates when the span is full, and reading them does not chase pointers.
+typedef struct {
+    size_t count;
+    size_t capacity;
+    void *values[];
+} value_span_t;
 
-static void node_destructor_single(void *ptr, void *meta) {
-    ccbucket_node_t *node = ptr;
-    struct destructor_data *data = meta;
-    if(data->destructor) data->destructor(node->one_value, data->user_data);
-    cc_free(node);
+#define SPAN_MIN_CAPACITY (4)
+
+static inline size_t span_size(size_t capacity) {
+    return sizeof(value_span_t) + capacity * sizeof(void *);
 }
 
-static void value_destructor_many(void *ptr, void *meta) {
-    ccbucket_value_t *value = ptr;
-    struct destructor_data *data = meta;
-    if(data->destructor) data->destructor(value->value, data->user_data);
-    cc_free(value);
+// Appends [object] to [span], which can be NULL, and returns the span, which may have moved.
+static value_span_t *span_push(cctable_t *table, value_span_t *span, void *object) {
+    if(!span || span->count == span->capacity) {
+        size_t old_capacity = span ? span->capacity : 0;
+        size_t capacity = old_capacity ? old_capacity * 2 : SPAN_MIN_CAPACITY;
+        span = cc_realloc_with(
+            table->allocator,
+            span,
+            span ? span_size(old_capacity) : 0,
+            span_size(capacity)
+        );
+        if(!old_capacity) span->count = 0;
+        span->capacity = capacity;
+    }
+    span->values[span->count++] = object;
+    return span;
 }
 
-static void node_destructor_many(void *ptr, void *meta) {
-    ccbucket_node_t *node = ptr;
-    struct destructor_data *data = meta;
-    cclist_clear(&node->many_values, value_destructor_many, data);
-    cc_free(node);
+static void span_delete(cctable_t *table, value_span_t *span, cc_destructor des, void *user_data) {
+    if(des) {
+        for(size_t i = 0; i < span->count; ++i) des(span->values[i], user_data);
+    }
+    cc_free_with(table->allocator, span, span_size(span->capacity));
 }
 
-void cctable_deinit(cctable_t *table, cc_destructor des, void *ptr) {
-    CCASSERT(table);
+static inline cctable_values_t span_view(const value_span_t *span) {
+    return (cctable_values_t){(void *const *)span->values, span->count};
+}
 
-    struct destructor_data data;
-    data.destructor = des;
-    data.user_data = ptr;
+// MARK: - Index
 
-    cc_destructor node_destructor = table->allow_multiple
-        ? node_destructor_many
-        : node_destructor_single;
+static bool entry_hash(const void *ptr, size_t *hash) {
+    const cctable_entry_t *entry = ptr;
+    if(!entry->key) return false;
+    *hash = entry->hash;
+    return true;
+}
 
-    for(size_t i = 0; i < table->capacity; ++i) {
-        cclist_clear(&table->buckets[i], node_destructor, &data);
-    }
-    cc_free(table->buckets);
-    table->capacity = 0;
-    table->size = 0;
-    table->buckets = NULL;
+static const index_ops_t entry_ops = {sizeof(cctable_entry_t), entry_hash};
+
+static cctable_entry_t *table_find(const cctable_t *table, const table_key_t *key) {
+    size_t position = index_find(
+        &table->index,
+        table->entries.data,
+        sizeof(cctable_entry_t),
+        key->hash,
+        key_equals,
+        key
+    );
+    return position != INDEX_NOT_FOUND ? &table->entries.data[position] : NULL;
 }
 
-static void cctable_insert_single(cctable_t *table, const char *key, void *object) {
-    size_t key_length = strlen(key);
+static cctable_entry_t *table_add(cctable_t *table, const table_key_t *key) {
+    size_t position = index_add(&table->index, &table->entries.base, &entry_ops, key->hash);
+    CC_VEC_PUSH(&table->entries, ((cctable_entry_t){
+        .key = key_new(table, key->data, key->length),
+        .value = NULL,
+        .hash = key->hash,
+        .length = key->length,
+    }));
+    cctable_entry_t *entry = &table->entries.data[position];
 
-    size_t bucket_idx = hash_string(key) & (table->capacity-1);
-    cclist_t *bucket = &table->buckets[bucket_idx];
-    for(ccbucket_node_t *node = cclist_first(bucket); node; node = cclist_next(bucket, node)) {
-        if(!strcmp(key, node->key)) return;
+    if(table->probe_hook) {
+        size_t probes = index_probe_length(&table->index, key->hash, position);
+        if(probes > table->probe_limit) {
+            table->probe_hook(table, entry, probes, table->probe_hook_data);
+        }
     }
+    return entry;
+}
+
+static void table_insert(cctable_t *table, const table_key_t *key, void *object) {
+    cctable_entry_t *entry = table_find(table, key);
+    if(entry && !table->allow_multiple) return;
 
-    ccbucket_node_t *new_node = cc_alloc(sizeof(ccbucket_node_t) + key_length + 1);
+    if(!entry) entry = table_add(table, key);
 
-    memcpy(new_node->key, key, key_length);
-    new_node->key[key_length] = 0;
-    new_node->one_value = object;
-    cclist_insert_first(bucket, new_node);
+    if(table->allow_multiple) {
+        entry->value = span_push(table, entry->value, object);
+    } else {
+        entry->value = object;
+    }
     table->size += 1;
 }
 
-ccbucket_value_t *value_many_new(void *object) {
-    ccbucket_value_t *value = cc_alloc(sizeof(ccbucket_value_t));
-    value->value = object;
-    return value;
+// MARK: - Public API
+
+void cctable_init(cctable_t *table, size_t count, bool allow_multiple) {
+    cctable_init_with(table, count, allow_multiple, NULL);
 }
 
-static void cctable_insert_many(cctable_t *table, const char *key, void *object) {
-    size_t key_length = strlen(key);
+void cctable_init_arena(cctable_t *table, size_t count, bool allow_multiple, cc_arena_t *arena) {
+    CCASSERT(arena);
+    cctable_init_with(table, count, allow_multiple, cc_arena_allocator(arena));
+}
 
-    size_t bucket_idx = hash_string(key) & (table->capacity-1);
-    cclist_t *bucket = &table->buckets[bucket_idx];
-    for(ccbucket_node_t *node = cclist_first(bucket); node; node = cclist_next(bucket, node)) {
-        if(strcmp(key, node->key)) continue;
-        table->size += 1;
-        return cclist_insert_first(&node->many_values, value_many_new(object));
+void cctable_init_with(
+    cctable_t *table,
+    size_t count,
+    bool allow_multiple,
+    const cc_allocator_t *allocator
+) {
+    CCASSERT(table);
+    table->size = 0;
+    table->allocator = allocator;
+    table->allow_multiple = allow_multiple;
+    table->probe_hook = NULL;
+    table->probe_hook_data = NULL;
+    table->probe_limit = 0;
+    index_init(&table->index, count, allocator);
+    CC_VEC_INIT_WITH(&table->entries, allocator);
+    CC_VEC_RESERVE(&table->entries, count);
+
+    for(size_t i = 0; i < CCTABLE_KEY_CLASSES; ++i) {
+        cc_pool_init_with(&table->key_pools[i], CCTABLE_KEY_CLASS_SIZE * i + 1, allocator);
     }
+}
 
-    ccbucket_node_t *new_node = cc_alloc(sizeof(ccbucket_node_t) + key_length + 1);
+void cctable_reserve(cctable_t *table, size_t count) {
+    CCASSERT(table);
+    index_reserve(&table->index, &table->entries.base, &entry_ops, count);
+}
 
-    memcpy(new_node->key, key, key_length);
-    new_node->key[key_length] = 0;
-    cclist_init(&new_node->many_values, offsetof(ccbucket_value_t, list_node));
-    cclist_insert_first(bucket, new_node);
-    table->size += 1;
-    cclist_insert_first(&new_node->many_values, value_many_new(object));
+void cctable_deinit(cctable_t *table, cc_destructor des, void *ptr) {
+    CCASSERT(table);
+
+    for(size_t i = 0; i < table->entries.count; ++i) {
+        cctable_entry_t *entry = &table->entries.data[i];
+        if(!entry->key) continue;
+        if(table->allow_multiple) {
+            span_delete(table, entry->value, des, ptr);
+        } else if(des) {
+            des(entry->value, ptr);
+        }
+        if(key_class(entry->length) == CCTABLE_KEY_CLASSES) {
+            key_delete(table, entry->key, entry->length);
+        }
+    }
+    for(size_t i = 0; i < CCTABLE_KEY_CLASSES; ++i) {
+        cc_pool_deinit(&table->key_pools[i]);
+    }
+    CC_VEC_DEINIT(&table->entries);
+    index_deinit(&table->index);
+    table->size = 0;
 }
 
 void cctable_insert(cctable_t *table, const char *key, void *object) {
+    CCASSERT(key);
+    cctable_insert_n(table, key, strlen(key), object);
+}
+
+void cctable_insert_n(cctable_t *table, const char *key, size_t length, void *object) {
+    CCASSERT(table);
+    index_step(&table->index, &table->entries.base, &entry_ops);
+
+    table_key_t k = make_key(key, length);
+    table_insert(table, &k, object);
+}
+
+void **cctable_upsert(cctable_t *table, const char *key, bool *inserted) {
+    CCASSERT(key);
+    return cctable_upsert_n(table, key, strlen(key), inserted);
+}
+
+void **cctable_upsert_n(cctable_t *table, const char *key, size_t length, bool *inserted) {
     CCASSERT(table);
+    CCASSERT(!table->allow_multiple);
+    index_step(&table->index, &table->entries.base, &entry_ops);
+
+    table_key_t k = make_key(key, length);
+    cctable_entry_t *entry = table_find(table, &k);
+    if(inserted) *inserted = !entry;
+    if(!entry) {
+        entry = table_add(table, &k);
+        table->size += 1;
+    }
+    return &entry->value;
+}
+
+bool cctable_remove(cctable_t *table, const char *key, cc_destructor des, void *user_data) {
     CCASSERT(key);
+    return cctable_remove_n(table, key, strlen(key), des, user_data);
+}
+
+bool cctable_remove_n(
+    cctable_t *table,
+    const char *key,
+    size_t length,
+    cc_destructor des,
+    void *user_data
+) {
+    CCASSERT(table);
+
+    table_key_t k = make_key(key, length);
+    cctable_entry_t *entry = table_find(table, &k);
+    if(!entry) return false;
+
+    index_remove(&table->index, k.hash, entry - table->entries.data);
+
     if(table->allow_multiple) {
-        cctable_insert_many(table, key, object);
+        table->size -= ((value_span_t *)entry->value)->count;
+        span_delete(table, entry->value, des, user_data);
     } else {
-        cctable_insert_single(table, key, object);
+        table->size -= 1;
+        if(des) des(entry->value, user_data);
     }
+
+    key_delete(table, entry->key, entry->length);
+    entry->key = NULL;
+    entry->value = NULL;
+    return true;
 }
 
-const cclist_t *cctable_get_many(const cctable_t *table, const char *key) {
-    CCASSERT(table);
+cctable_values_t cctable_get_many(const cctable_t *table, const char *key) {
     CCASSERT(key);
+    return cctable_get_many_n(table, key, strlen(key));
+}
+
+cctable_values_t cctable_get_many_n(const cctable_t *table, const char *key, size_t length) {
+    CCASSERT(table);
     CCASSERT(table->allow_multiple);
 
-    size_t bucket_idx = hash_string(key) & (table->capacity-1);
-    cclist_t *bucket = &table->buckets[bucket_idx];
+    table_key_t k = make_key(key, length);
+    const cctable_entry_t *entry = table_find(table, &k);
+    return entry ? span_view(entry->value) : (cctable_values_t){NULL, 0};
+}
 
-    for(ccbucket_node_t *node = cclist_first(bucket); node; node = cclist_next(bucket, node)) {
-        if(strcmp(key, node->key)) continue;
-        return &node->many_values;
-    }
-    return NULL;
+cctable_values_t cctable_entry_values(const cctable_t *table, const cctable_entry_t *entry) {
+    CCASSERT(table);
+    CCASSERT(table->allow_multiple);
+    CCASSERT(entry);
+    return span_view(entry->value);
 }
 
 void *cctable_get_one(const cctable_t *table, const char *key) {
-    CCASSERT(table);
     CCASSERT(key);
+    return cctable_get_one_n(table, key, strlen(key));
+}
+
+void *cctable_get_one_n(const cctable_t *table, const char *key, size_t length) {
+    CCASSERT(table);
     CCASSERT(!table->allow_multiple);
 
-    size_t bucket_idx = hash_string(key) & (table->capacity-1);
-    cclist_t *bucket = &table->buckets[bucket_idx];
+    table_key_t k = make_key(key, length);
+    const cctable_entry_t *entry = table_find(table, &k);
+    return entry ? entry->value : NULL;
+}
+
+void cctable_iter(const cctable_t *table, cctable_callback_f callback, void *ptr) {
+    CCASSERT(table);
+    CCASSERT(callback);
 
-    for(ccbucket_node_t *node = cclist_first(bucket); node; node = cclist_next(bucket, node)) {
-        if(strcmp(key, node->key)) continue;
-        return node->one_value;
+    for(size_t i = 0; i < table->entries.count; ++i) {
+        const cctable_entry_t *entry = &table->entries.data[i];
+        if(!entry->key) continue;
+        if(!table->allow_multiple) {
+            callback(entry->key, entry->value, ptr);
+            continue;
+        }
+        const value_span_t *span = entry->value;
+        for(size_t j = 0; j < span->count; ++j) {
+            callback(entry->key, span->values[j], ptr);
+        }
+    }
+}
+
+cctable_cursor_t cctable_cursor(const cctable_t *table) {
+    CCASSERT(table);
+    return (cctable_cursor_t){table, 0};
+}
+
+const cctable_entry_t *cctable_next(cctable_cursor_t *cursor) {
+    CCASSERT(cursor);
+    const cctable_t *table = cursor->table;
+    while(cursor->position < table->entries.count) {
+        const cctable_entry_t *entry = &table->entries.data[cursor->position++];
+        if(entry->key) return entry;
     }
     return NULL;
 }
 
-void cctable_iter(const cctable_t *table, cctable_callback_f callback, void *ptr) {
+// MARK: - Bulk build
+
+// Bulk builds hash and deduplicate the keys on the thread pool before touching the table:
+//  1. each chunk of the input hashes its keys and counts how many fall in each partition;
+//  2. each chunk then scatters its keys into one contiguous, ordered run per partition;
+//  3. each partition finds the duplicates among its keys, chaining every occurrence of a key to
+//     the first one, in input order.
+// Partitions are picked from the hash, so duplicates always land in the same one. The table is
+// then sized once, and the distinct keys added in a single serial pass.
+
+// Below this many keys, hashing on the pool costs more than it saves.
+#define BUILD_MIN_PARALLEL (4096)
+// Chunks and partitions per worker thread, so that uneven ones still keep every worker busy.
+#define BUILD_SPLIT_PER_THREAD (4)
+
+typedef struct {
+    size_t hash;
+    size_t length;
+    size_t next;    // The next occurrence of the same key, or SIZE_MAX.
+    size_t last;    // The last occurrence of the key so far, if this is the first one.
+    size_t count;   // Occurrences of the key if this is the first one, or 0 for duplicates.
+} build_key_t;
+
+typedef struct {
+    const char *const *keys;
+    const size_t *lengths;
+    size_t count;
+    build_key_t *info;
+
+    size_t chunk_size;
+    size_t chunk_count;
+    size_t partition_count;
+    size_t *counts;         // [chunk * partition_count + partition]
+    size_t *partitions;     // partition_count + 1 starting offsets into [order].
+    size_t *order;
+
+    pthread_mutex_t mt;
+    pthread_cond_t done_cv;
+    size_t pending;
+} build_t;
+
+typedef struct {
+    build_t *build;
+    size_t index;
+    void (*fn)(build_t *build, size_t index);
+} build_task_t;
+
+// Partitions come from the upper half of the hash, since the dedup pass probes with the lower one.
+static inline size_t build_partition(const build_t *build, size_t hash) {
+    return (hash >> (sizeof(size_t) * 4)) & (build->partition_count - 1);
+}
+
+// The last chunks can be empty, when the keys don't split evenly.
+static inline size_t build_chunk_end(const build_t *build, size_t start) {
+    if(start >= build->count) return start;
+    return build->count - start > build->chunk_size ? start + build->chunk_size : build->count;
+}
+
+static void build_hash_chunk(build_t *build, size_t chunk) {
+    size_t start = chunk * build->chunk_size;
+    size_t end = build_chunk_end(build, start);
+    size_t *counts = build->counts + chunk * build->partition_count;
+
+    for(size_t i = start; i < end; ++i) {
+        const char *key = build->keys[i];
+        CCASSERT(key);
+        size_t length = build->lengths ? build->lengths[i] : strlen(key);
+        size_t hash = cc_hash_bytes(key, length, 0);
+        build->info[i] = (build_key_t){hash, length, SIZE_MAX, i, 1};
+        counts[build_partition(build, hash)] += 1;
+    }
+}
+
+static void build_scatter_chunk(build_t *build, size_t chunk) {
+    size_t start = chunk * build->chunk_size;
+    size_t end = build_chunk_end(build, start);
+    size_t *offsets = build->counts + chunk * build->partition_count;
+
+    for(size_t i = start; i < end; ++i) {
+        build->order[offsets[build_partition(build, build->info[i].hash)]++] = i;
+    }
+}
+
+static bool build_key_equals(const build_t *build, size_t a, size_t b) {
+    const build_key_t *ka = &build->info[a];
+    const build_key_t *kb = &build->info[b];
+    return ka->hash == kb->hash
+        && ka->length == kb->length
+        && !memcmp(build->keys[a], build->keys[b], ka->length);
+}
+
+// Deduplicates the keys of [partition] with a small linear-probing set of their first occurrences.
+static void build_dedup_partition(build_t *build, size_t partition) {
+    const size_t *order = build->order + build->partitions[partition];
+    size_t count = build->partitions[partition + 1] - build->partitions[partition];
+    if(count < 2) return;
+
+    size_t capacity = 4;
+    while(capacity < count * 2) capacity *= 2;
+
+    // Each slot holds the first occurrence of a key, which tracks the last one found so far.
+    uint32_t *slots = cc_alloc(capacity * sizeof(uint32_t));
+    memset(slots, 0xff, capacity * sizeof(uint32_t));
+
+    for(size_t i = 0; i < count; ++i) {
+        size_t key = order[i];
+        size_t slot = build->info[key].hash & (capacity - 1);
+        while(slots[slot] != UINT32_MAX && !build_key_equals(build, slots[slot], key)) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        if(slots[slot] == UINT32_MAX) {
+            slots[slot] = key;
+            continue;
+        }
+        build_key_t *first = &build->info[slots[slot]];
+        build->info[first->last].next = key;
+        build->info[key].count = 0;
+        first->last = key;
+        first->count += 1;
+    }
+    cc_free(slots);
+}
+
+static void build_task(void *refcon) {
+    build_task_t *task = refcon;
+    build_t *build = task->build;
+    task->fn(build, task->index);
+
+    pthread_mutex_lock(&build->mt);
+    if(--build->pending == 0) pthread_cond_signal(&build->done_cv);
+    pthread_mutex_unlock(&build->mt);
+}
+
+// Runs [fn] for indices 0 to [count] - 1 on the pool, and waits for all of them to finish.
+static void build_run(
+    build_t *build,
+    build_task_t *tasks,
+    size_t count,
+    void (*fn)(build_t *, size_t)
+) {
+    build->pending = count;
+    for(size_t i = 0; i < count; ++i) {
+        tasks[i] = (build_task_t){build, i, fn};
+        ccpool_submit(build_task, &tasks[i]);
+    }
+    pthread_mutex_lock(&build->mt);
+    while(build->pending) pthread_cond_wait(&build->done_cv, &build->mt);
+    pthread_mutex_unlock(&build->mt);
+}
+
+// Adds the key at [i] with the values of all of its occurrences. Keys are only looked up in the
+// table if it had entries before the build, since the dedup pass already merged the new ones.
+static void build_place(
+    cctable_t *table,
+    const build_t *build,
+    size_t i,
+    void *const *values,
+    bool lookup
+) {
+    const build_key_t *info = &build->info[i];
+    table_key_t k = {build->keys[i], info->length, info->hash};
+    cctable_entry_t *entry = lookup ? table_find(table, &k) : NULL;
+
+    if(!table->allow_multiple) {
+        if(entry) return;
+        table_add(table, &k)->value = values[i];
+        table->size += 1;
+        return;
+    }
+
+    if(!entry) {
+        entry = table_add(table, &k);
+        size_t capacity = info->count > SPAN_MIN_CAPACITY ? info->count : SPAN_MIN_CAPACITY;
+        value_span_t *span = cc_alloc_with(table->allocator, span_size(capacity));
+        span->count = 0;
+        span->capacity = capacity;
+        entry->value = span;
+    }
+    for(size_t j = i; j != SIZE_MAX; j = build->info[j].next) {
+        entry->value = span_push(table, entry->value, values[j]);
+    }
+    table->size += info->count;
+}
+
+// Without workers to share the hashing, a separate dedup pass costs more than it saves: the table
+// is sized for every key instead, and each one is inserted directly.
+static void build_serial(
+    cctable_t *table,
+    const char *const *keys,
+    const size_t *lengths,
+    void *const *values,
+    size_t count,
+    size_t live
+) {
+    cctable_reserve(table, live + count);
+    for(size_t i = 0; i < count; ++i) {
+        CCASSERT(keys[i]);
+        size_t length = lengths ? lengths[i] : strlen(keys[i]);
+        table_key_t k = make_key(keys[i], length);
+        table_insert(table, &k, values[i]);
+    }
+}
+
+void cctable_build(cctable_t *table, const char *const *keys, void *const *values, size_t count) {
+    cctable_build_n(table, keys, NULL, values, count);
+}
+
+void cctable_build_n(
+    cctable_t *table,
+    const char *const *keys,
+    const size_t *lengths,
+    void *const *values,
+    size_t count
+) {
     CCASSERT(table);
-    CCASSERT(callback);
+    if(!count) return;
+    CCASSERT(keys);
+    CCASSERT(values);
+
+    size_t live = table->entries.count - table->index.removed;
+    size_t threads = ccpool_thread_count();
+    if(!threads || count < BUILD_MIN_PARALLEL) {
+        build_serial(table, keys, lengths, values, count, live);
+        return;
+    }
+    CCASSERT(count < UINT32_MAX);
+
+    size_t split = 1;
+    while(split < threads * BUILD_SPLIT_PER_THREAD) split *= 2;
+
+    build_t build = {
+        .keys = keys,
+        .lengths = lengths,
+        .count = count,
+        .chunk_size = (count + split - 1) / split,
+        .chunk_count = split,
+        .partition_count = split,
+    };
+    build.info = cc_alloc(count * sizeof(build_key_t));
+    build.order = cc_alloc(count * sizeof(size_t));
+    build.counts = cc_alloc(split * split * sizeof(size_t));
+    build.partitions = cc_alloc((split + 1) * sizeof(size_t));
+    build_task_t *tasks = cc_alloc(split * sizeof(build_task_t));
+    memset(build.counts, 0, split * split * sizeof(size_t));
+    pthread_mutex_init(&build.mt, NULL);
+    pthread_cond_init(&build.done_cv, NULL);
+
+    build_run(&build, tasks, build.chunk_count, build_hash_chunk);
+
+    // Turn the per-chunk counts into the offset at which each chunk writes into each partition.
+    size_t offset = 0;
+    for(size_t p = 0; p < build.partition_count; ++p) {
+        build.partitions[p] = offset;
+        for(size_t c = 0; c < build.chunk_count; ++c) {
+            size_t *slot = &build.counts[c * build.partition_count + p];
+            size_t n = *slot;
+            *slot = offset;
+            offset += n;
+        }
+    }
+    build.partitions[build.partition_count] = offset;
+
+    build_run(&build, tasks, build.chunk_count, build_scatter_chunk);
+    build_run(&build, tasks, build.partition_count, build_dedup_partition);
+
+    size_t distinct = 0;
+    for(size_t i = 0; i < count; ++i) distinct += build.info[i].count != 0;
+    cctable_reserve(table, live + distinct);
+
+    for(size_t i = 0; i < count; ++i) {
+        if(build.info[i].count) build_place(table, &build, i, values, live != 0);
+    }
+
+    pthread_cond_destroy(&build.done_cv);
+    pthread_mutex_destroy(&build.mt);
+    cc_free(tasks);
+    cc_free(build.partitions);
+    cc_free(build.counts);
+    cc_free(build.order);
+    cc_free(build.info);
+}
+
+// MARK: - Statistics
+
+// Returns the number of bytes allocated for a key of [length] characters.
+static inline size_t key_size(size_t length) {
+    size_t cls = key_class(length);
+    return cls < CCTABLE_KEY_CLASSES ? CCTABLE_KEY_CLASS_SIZE * cls + 1 : length + 1;
+}
+
+void cctable_stats(const cctable_t *table, cctable_stats_t *stats) {
+    CCASSERT(table);
+    CCASSERT(stats);
+    memset(stats, 0, sizeof(*stats));
+
+    const cchash_index_t *index = &table->index;
+    stats->size = table->size;
+    stats->holes = index->removed;
+    stats->capacity = index->slots.capacity;
+    stats->tombstones = index_count_ctrl(&index->slots, CC_SWISS_DELETED);
+    stats->rehashing = index->old_slots.capacity != 0;
+    stats->index_bytes = index_slots_size(&index->slots) + index_slots_size(&index->old_slots);
+    stats->entry_bytes = table->entries.capacity * sizeof(cctable_entry_t);
+
+    size_t total_probes = 0;
+    for(size_t i = 0; i < table->entries.count; ++i) {
+        const cctable_entry_t *entry = &table->entries.data[i];
+        if(!entry->key) continue;
 
-    for(size_t i = 0; i < table->capacity; ++i) {
-        cclist_t *bucket = &table->buckets[i];
-        for(ccbucket_node_t *n = cclist_first(bucket); n; n = cclist_next(bucket, n)) {
-            if(!table->allow_multiple) {
-                callback(n->key, n->one_value, ptr);
-                continue;
-            }
-            for(ccbucket_value_t *value = cclist_first(&n->many_values);
-                value;
-                value = cclist_next(&n->many_values, value)) {
-                callback(n->key, value->value, ptr);
-            }
+        size_t probes = index_probe_length(index, entry->hash, i);
+        size_t bucket = probes < CCTABLE_PROBE_HISTOGRAM ? probes : CCTABLE_PROBE_HISTOGRAM;
+        stats->probe_histogram[bucket - 1] += 1;
+        if(probes > stats->max_probe) stats->max_probe = probes;
+        total_probes += probes;
+
+        stats->keys += 1;
+        stats->key_bytes += key_size(entry->length);
+        if(table->allow_multiple) {
+            stats->value_bytes += span_size(((const value_span_t *)entry->value)->capacity);
         }
     }
+
+    if(stats->capacity) {
+        size_t empty = index_count_ctrl(&index->slots, CC_SWISS_EMPTY);
+        stats->load = (double)(stats->capacity - empty) / stats->capacity;
+    }
+    if(stats->keys) stats->mean_probe = (double)total_probes / stats->keys;
+}
+
+void cctable_set_probe_hook(
+    cctable_t *table,
+    size_t limit,
+    cctable_probe_hook_f hook,
+    void *user_data
+) {
+    CCASSERT(table);
+    table->probe_limit = limit;
+    table->probe_hook = hook;
+    table->probe_hook_data = user_data;
+}
+
+void cctable_log_probe(
+    const cctable_t *table,
+    const cctable_entry_t *entry,
+    size_t probes,
+    void *user_data
+) {
+    CCUNUSED(user_data);
+    CCWARN(
+        "table %p: key '%.*s' (hash %016zx) takes %zu probes to find",
+        (const void *)table,
+        (int)entry->length,
+        entry->key,
+        entry->hash,
+        probes
+    );
 }
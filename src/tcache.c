@@ -0,0 +1,264 @@
+//===--------------------------------------------------------------------------------------------===
+// tcache - thread-local caching front-end for cc_alloc()
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#include "tcache.h"
+#include <ccore/log.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Small blocks are rounded up to a size class: 16-byte steps up to 256 bytes, then 128-byte steps
+// up to TCACHE_MAX_SIZE. Each thread keeps two magazines of free blocks per class, Bonwick-style:
+// allocating and freeing only touch the thread's magazines, and only when both are empty (or
+// full) does the thread trade a whole magazine with the class's depot, under a lock.
+//
+// Blocks don't belong to a thread. A block freed by another thread than the one that allocated it
+// simply goes in the freeing thread's magazines, and flows back through the depot from there.
+// This keeps producer/consumer patterns (tasks allocated by a submitter, freed by a worker) cheap.
+
+#define SMALL_STEP (16)
+#define SMALL_MAX (256)
+#define LARGE_STEP (128)
+#define CLASS_COUNT (SMALL_MAX / SMALL_STEP + (TCACHE_MAX_SIZE - SMALL_MAX) / LARGE_STEP)
+#define CLASS_UNCACHED (UINT32_MAX)
+
+typedef struct {
+    size_t size;
+    uint32_t cls;
+} header_t;
+
+#define HEADER_SIZE \
+    ((sizeof(header_t) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+
+// A free block. Magazines are chains of blocks linked through [next]; full magazines stored in a
+// depot are linked together through their first block's [next_magazine].
+typedef struct free_block_s {
+    struct free_block_s *next;
+    struct free_block_s *next_magazine;
+} free_block_t;
+
+typedef struct {
+    free_block_t *loaded;
+    free_block_t *previous;
+    uint32_t loaded_count;
+    uint32_t previous_count;
+} bin_t;
+
+typedef struct {
+    bool registered;
+    bin_t bins[CLASS_COUNT];
+} thread_cache_t;
+
+typedef struct {
+    pthread_mutex_t mt;
+    free_block_t *magazines;
+    free_block_t *loose;
+} depot_t;
+
+static _Thread_local thread_cache_t thread_cache;
+static depot_t depots[CLASS_COUNT];
+static pthread_once_t tcache_once = PTHREAD_ONCE_INIT;
+static pthread_key_t thread_key;
+
+static inline uint32_t class_of(size_t size) {
+    if(size <= SMALL_MAX) return size ? (size - 1) / SMALL_STEP : 0;
+    return SMALL_MAX / SMALL_STEP + (size - SMALL_MAX - 1) / LARGE_STEP;
+}
+
+static inline size_t class_size(uint32_t cls) {
+    if(cls < SMALL_MAX / SMALL_STEP) return (cls + 1) * SMALL_STEP;
+    return SMALL_MAX + (cls - SMALL_MAX / SMALL_STEP + 1) * LARGE_STEP;
+}
+
+static inline header_t *get_header(void *ptr) {
+    return (header_t *)((unsigned char *)ptr - HEADER_SIZE);
+}
+
+static inline void *get_ptr(header_t *header) {
+    return (unsigned char *)header + HEADER_SIZE;
+}
+
+static void thread_exit(void *data);
+
+static void tcache_init(void) {
+    for(uint32_t i = 0; i < CLASS_COUNT; ++i) {
+        pthread_mutex_init(&depots[i].mt, NULL);
+        depots[i].magazines = NULL;
+        depots[i].loose = NULL;
+    }
+    pthread_key_create(&thread_key, thread_exit);
+}
+
+// Threads register the first time they touch the cache, so that their magazines are given back
+// to the depots when they exit.
+static void register_thread(void) {
+    pthread_once(&tcache_once, tcache_init);
+    thread_cache.registered = true;
+    pthread_setspecific(thread_key, &thread_cache);
+}
+
+// Carves a fresh magazine out of a new slab from the backend allocator. Slabs are never returned:
+// their blocks live on in the depots once freed.
+static free_block_t *carve_magazine(uint32_t cls) {
+    size_t stride = HEADER_SIZE + class_size(cls);
+    unsigned char *slab = cc_backend_alloc(NULL, stride * TCACHE_MAGAZINE_SIZE);
+
+    free_block_t *head = NULL;
+    for(int i = TCACHE_MAGAZINE_SIZE - 1; i >= 0; --i) {
+        header_t *header = (header_t *)(slab + i * stride);
+        header->cls = cls;
+        header->size = class_size(cls);
+        free_block_t *block = get_ptr(header);
+        block->next = head;
+        head = block;
+    }
+    return head;
+}
+
+static void refill(bin_t *bin, uint32_t cls) {
+    if(!thread_cache.registered) register_thread();
+    depot_t *depot = &depots[cls];
+
+    pthread_mutex_lock(&depot->mt);
+    if(depot->magazines) {
+        bin->loaded = depot->magazines;
+        bin->loaded_count = TCACHE_MAGAZINE_SIZE;
+        depot->magazines = depot->magazines->next_magazine;
+    } else if(depot->loose) {
+        free_block_t *tail = depot->loose;
+        uint32_t count = 1;
+        while(tail->next && count < TCACHE_MAGAZINE_SIZE) {
+            tail = tail->next;
+            count += 1;
+        }
+        bin->loaded = depot->loose;
+        bin->loaded_count = count;
+        depot->loose = tail->next;
+        tail->next = NULL;
+    } else {
+        bin->loaded = NULL;
+    }
+    pthread_mutex_unlock(&depot->mt);
+
+    if(!bin->loaded) {
+        bin->loaded = carve_magazine(cls);
+        bin->loaded_count = TCACHE_MAGAZINE_SIZE;
+    }
+}
+
+static void flush(bin_t *bin, uint32_t cls) {
+    CCASSERT(bin->previous_count == TCACHE_MAGAZINE_SIZE);
+    depot_t *depot = &depots[cls];
+
+    pthread_mutex_lock(&depot->mt);
+    bin->previous->next_magazine = depot->magazines;
+    depot->magazines = bin->previous;
+    pthread_mutex_unlock(&depot->mt);
+
+    bin->previous = NULL;
+    bin->previous_count = 0;
+}
+
+static void give_back_loose(free_block_t *chain, uint32_t cls) {
+    if(!chain) return;
+    free_block_t *tail = chain;
+    while(tail->next) tail = tail->next;
+
+    depot_t *depot = &depots[cls];
+    pthread_mutex_lock(&depot->mt);
+    tail->next = depot->loose;
+    depot->loose = chain;
+    pthread_mutex_unlock(&depot->mt);
+}
+
+static void thread_exit(void *data) {
+    thread_cache_t *cache = data;
+    for(uint32_t cls = 0; cls < CLASS_COUNT; ++cls) {
+        bin_t *bin = &cache->bins[cls];
+        give_back_loose(bin->loaded, cls);
+        give_back_loose(bin->previous, cls);
+        bin->loaded = bin->previous = NULL;
+        bin->loaded_count = bin->previous_count = 0;
+    }
+    cache->registered = false;
+}
+
+void *tcache_alloc(size_t size) {
+    if(size > TCACHE_MAX_SIZE) {
+        header_t *header = cc_backend_alloc(NULL, HEADER_SIZE + size);
+        header->cls = CLASS_UNCACHED;
+        header->size = size;
+        return get_ptr(header);
+    }
+
+    uint32_t cls = class_of(size);
+    bin_t *bin = &thread_cache.bins[cls];
+    if(!bin->loaded_count) {
+        if(bin->previous_count) {
+            bin->loaded = bin->previous;
+            bin->loaded_count = bin->previous_count;
+            bin->previous = NULL;
+            bin->previous_count = 0;
+        } else {
+            refill(bin, cls);
+        }
+    }
+
+    free_block_t *block = bin->loaded;
+    bin->loaded = block->next;
+    bin->loaded_count -= 1;
+    return block;
+}
+
+void tcache_free(void *ptr) {
+    if(!ptr) return;
+    header_t *header = get_header(ptr);
+    if(header->cls == CLASS_UNCACHED) {
+        cc_backend_alloc(header, 0);
+        return;
+    }
+
+    uint32_t cls = header->cls;
+    bin_t *bin = &thread_cache.bins[cls];
+    if(bin->loaded_count == TCACHE_MAGAZINE_SIZE) {
+        if(bin->previous_count) flush(bin, cls);
+        bin->previous = bin->loaded;
+        bin->previous_count = bin->loaded_count;
+        bin->loaded = NULL;
+        bin->loaded_count = 0;
+    } else if(!bin->loaded_count && !thread_cache.registered) {
+        register_thread();
+    }
+
+    free_block_t *block = ptr;
+    block->next = bin->loaded;
+    bin->loaded = block;
+    bin->loaded_count += 1;
+}
+
+void *tcache_realloc(void *ptr, size_t size) {
+    if(!ptr) return tcache_alloc(size);
+    if(!size) {
+        tcache_free(ptr);
+        return NULL;
+    }
+
+    header_t *header = get_header(ptr);
+    if(header->cls == CLASS_UNCACHED && size > TCACHE_MAX_SIZE) {
+        header = cc_backend_alloc(header, HEADER_SIZE + size);
+        header->size = size;
+        return get_ptr(header);
+    }
+    if(header->cls != CLASS_UNCACHED && size <= header->size) return ptr;
+
+    void *new_ptr = tcache_alloc(size);
+    memcpy(new_ptr, ptr, header->size < size ? header->size : size);
+    tcache_free(ptr);
+    return new_ptr;
+}
@@ -0,0 +1,23 @@
+//===--------------------------------------------------------------------------------------------===
+// tcache - private header for the thread-local allocation cache
+//
+// Created by Amy Parent <amy@amyparent.com>
+// Copyright (c) 2026 Amy Parent
+// Licensed under the MIT License
+// =^•.•^=
+//===--------------------------------------------------------------------------------------------===
+#pragma once
+#include <stddef.h>
+
+/// Allocations larger than this bypass the cache and go straight to the backend allocator.
+#define TCACHE_MAX_SIZE (1024)
+
+/// The number of blocks moved between a thread's cache and the global depot at once.
+#define TCACHE_MAGAZINE_SIZE (64)
+
+void *tcache_alloc(size_t size);
+void *tcache_realloc(void *ptr, size_t size);
+void tcache_free(void *ptr);
+
+/// The allocator installed with cc_set_allocator(), provided by memory.c.
+void *cc_backend_alloc(void *ptr, size_t size);
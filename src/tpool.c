@@ -19,23 +19,21 @@ static void *pool_worker(void *refcon) {
 
     for(;;) {
         pthread_mutex_lock(&pool->mt);
-        while(!pool->tasks.size && !pool->stop) pthread_cond_wait(&pool->cv, &pool->mt);
+        while(ccring_empty(&pool->tasks) && !pool->stop) pthread_cond_wait(&pool->cv, &pool->mt);
         if(pool->stop) {
             pthread_mutex_unlock(&pool->mt);
             break;
         }
 
-        task_t *task = cclist_first(&pool->tasks);
-        cclist_remove_first(&pool->tasks);
+        task_t task;
+        ccring_pop_front(&pool->tasks, &task);
 
         pool->in_work += 1;
         pthread_mutex_unlock(&pool->mt);
 
-        CCASSERT(task);
-        CCASSERT(task->fn);
+        CCASSERT(task.fn);
 
-        task->fn(task->refcon);
-        cc_free(task);
+        task.fn(task.refcon);
 
         pthread_mutex_lock(&pool->mt);
         pool->in_work -= 1;
@@ -52,7 +50,7 @@ void ccpool_start(int num_threads) {
         pool->thread_count = num_threads;
         pool->stop = false;
         pool->in_work = 0;
-        cclist_init(&pool->tasks, offsetof(task_t, list_node));
+        ccring_init(&pool->tasks, sizeof(task_t));
         pthread_mutex_init(&pool->mt, NULL);
         pthread_cond_init(&pool->cv, NULL);
         pthread_cond_init(&pool->idle_cv, NULL);
@@ -64,23 +62,19 @@ void ccpool_start(int num_threads) {
     pthread_mutex_unlock(&single_mt);
 }
 
-static void task_destructor(void *task, void *refcon) {
-    CCUNUSED(refcon);
-    cc_free(task);
-}
-
 void ccpool_stop() {
     pthread_mutex_lock(&single_mt);
     if(pool) {
         pthread_mutex_lock(&pool->mt);
         pool->stop = true;
-        cclist_clear(&pool->tasks, task_destructor, NULL);
+        ccring_clear(&pool->tasks);
         pthread_cond_broadcast(&pool->cv);
         pthread_mutex_unlock(&pool->mt);
 
         for(uint8_t i = 0; i < pool->thread_count; ++i) {
             pthread_join(pool->workers[i], NULL);
         }
+        ccring_deinit(&pool->tasks);
         cc_free(pool);
         pool = NULL;
     }
@@ -90,12 +84,10 @@ void ccpool_stop() {
 void ccpool_submit(ccpool_task_t fn, void *refcon) {
     CCASSERT(fn);
     CCASSERT(pool);
-    task_t *task = cc_alloc(sizeof (task_t));
-    task->fn = fn;
-    task->refcon = refcon;
 
     pthread_mutex_lock(&pool->mt);
-    cclist_insert_last(&pool->tasks, task);
+    task_t task = {.fn = fn, .refcon = refcon};
+    ccring_push_back(&pool->tasks, &task);
     pthread_cond_signal(&pool->cv);
     pthread_mutex_unlock(&pool->mt);
 }
@@ -103,6 +95,13 @@ void ccpool_submit(ccpool_task_t fn, void *refcon) {
 void ccpool_wait() {
     CCASSERT(pool);
     pthread_mutex_lock(&pool->mt);
-    while(pool->in_work || pool->tasks.size) pthread_cond_wait(&pool->idle_cv, &pool->mt);
+    while(pool->in_work || !ccring_empty(&pool->tasks)) pthread_cond_wait(&pool->idle_cv, &pool->mt);
     pthread_mutex_unlock(&pool->mt);
 }
+
+int ccpool_thread_count() {
+    pthread_mutex_lock(&single_mt);
+    int count = pool ? pool->thread_count : 0;
+    pthread_mutex_unlock(&single_mt);
+    return count;
+}
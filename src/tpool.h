@@ -7,7 +7,7 @@
 // =^•.•^=
 //===--------------------------------------------------------------------------------------------===
 #pragma once
-#include <ccore/list.h>
+#include <ccore/ring.h>
 #include <ccore/tpool.h>
 #include <pthread.h>
 #include <stdint.h>
@@ -16,12 +16,11 @@
 typedef struct task_s {
     ccpool_task_t fn;
     void *refcon;
-    cclist_node_t list_node;
 } task_t;
 
 
 typedef struct tpool_s {
-    cclist_t tasks;
+    ccring_t tasks;
     bool stop;
 
     pthread_mutex_t mt;
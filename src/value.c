@@ -14,7 +14,12 @@
 #define GC_INITIAL_THRESHOLD (128)
 
 void gc_init(obj_gc_t *gc) {
+    gc_init_with(gc, NULL);
+}
+
+void gc_init_with(obj_gc_t *gc, const cc_allocator_t *allocator) {
     CCASSERT(gc);
+    gc->allocator = allocator;
     gc->mark_flag = true;
     gc->allocated = 0;
     gc->next_collect = GC_INITIAL_THRESHOLD;
@@ -28,11 +33,11 @@ void gc_deinit(obj_gc_t *gc) {
     while(obj) {
         object_t *to_delete = obj;
         obj = obj->next;
-        cc_free(to_delete);
+        cc_free_with(gc->allocator, to_delete, to_delete->size);
     }
 
     // TODO: follow chain and deallocate
-    gc_init(gc);
+    gc_init_with(gc, gc->allocator);
 }
 
 void gc_collect(obj_gc_t *gc) {
@@ -48,13 +53,15 @@ void gc_collect(obj_gc_t *gc) {
 void *gc_new(obj_gc_t *gc, size_t size, int kind) {
     CCASSERT(gc);
     CCASSERT(size > sizeof(object_t));
-    object_t *obj = cc_alloc(size);
+    CCASSERT(size <= UINT32_MAX);
+    object_t *obj = cc_alloc_with(gc->allocator, size);
 
     gc->allocated += 1;
     if(gc->allocated > gc->next_collect) gc_collect(gc);
 
     obj->is_marked = !gc->mark_flag;
     obj->kind = kind;
+    obj->size = size;
     obj->next = gc->head;
     gc->head = obj;
     return obj;